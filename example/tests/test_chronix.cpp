@@ -1,28 +1,93 @@
+#include <array>
 #include <cassert>
+#include <future>
+#include <cstdlib>
 #include <iostream>
+#include <random>
+#include <unordered_set>
 
 #include "chronix/chronix.h"
 
 void test_immediate_job();
 void test_once_job();
 void test_cron_job();
+void test_clock_jump();
 
 void test_delete_job();
 void test_pause_resume_cron_job();
 void test_delete_running_job_should_throw();
 void test_pause_running_job_should_throw();
 
+void test_timing_wheel_queue();
+void test_timing_wheel_cron_job();
+void test_job_queue_remove_and_reposition();
+void test_remove_job_releases_job();
+void test_sharded_scheduler();
+void test_bulk_add_jobs();
+void test_slot_map_stale_ids();
+void test_fire_groups();
+void test_job_counters();
+void test_misfire_policies();
+void test_work_stealing_pool();
+void test_elastic_thread_pool();
+void test_unique_function();
+void test_priority_lanes();
+void test_executor_pools();
+void test_bounded_queue_policies();
+void test_submit_bulk();
+void test_worker_wait();
+void test_cpu_affinity();
+void test_cron_next_closed_form();
+void test_time_zones();
+void test_cron_enumeration();
+void test_cron_parser();
+void test_sub_second_jobs();
+void test_non_std_exceptions();
+#ifdef CHRONIX_COROUTINES
+void test_async_jobs();
+#endif
+
 int main(int argc, char** argv)
 {
     test_immediate_job();
     test_once_job();
     test_cron_job();
+    test_clock_jump();
 
     test_delete_job();
     test_pause_resume_cron_job();
     test_delete_running_job_should_throw();
     test_pause_running_job_should_throw();
 
+    test_timing_wheel_queue();
+    test_timing_wheel_cron_job();
+    test_job_queue_remove_and_reposition();
+    test_remove_job_releases_job();
+    test_sharded_scheduler();
+    test_bulk_add_jobs();
+    test_slot_map_stale_ids();
+    test_fire_groups();
+    test_job_counters();
+    test_misfire_policies();
+    test_work_stealing_pool();
+    test_elastic_thread_pool();
+    test_unique_function();
+    test_priority_lanes();
+    test_executor_pools();
+    test_bounded_queue_policies();
+    test_submit_bulk();
+    test_worker_wait();
+    test_cpu_affinity();
+    test_cron_next_closed_form();
+    test_time_zones();
+    test_cron_enumeration();
+    test_cron_parser();
+    test_sub_second_jobs();
+    test_non_std_exceptions();
+#ifdef CHRONIX_COROUTINES
+    test_async_jobs();
+#endif
+
     std::cout << "✅ All tests passed!" << std::endl;
     return 0;
 }
@@ -95,9 +160,41 @@ void test_cron_job()
     scheduler->stop();
 
     assert(run_count >= 5 && "❌ Task did not run!");
+    assert(scheduler->get_clock_jump_count() == 0 &&
+           "❌ Clock jump detected without a jump!");
     std::cout << "✅ Task ran!" << std::endl;
 }
 
+void test_clock_jump()
+{
+    using namespace std::chrono;
+
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 2);
+    std::atomic<bool> run{false};
+
+    scheduler->start();
+    scheduler->add_once_job(system_clock::now() + hours(1),
+                            [&]() { run = true; });
+    std::this_thread::sleep_for(milliseconds(300));
+    assert(!run && "❌ Job ran before its time!");
+
+    // 墙上时间向前跳一小时, 已入队的截止时间须按新锚点重算
+    scheduler->set_wall_clock(
+        []() { return system_clock::now() + hours(1) + seconds(1); });
+
+    auto deadline = steady_clock::now() + seconds(5);
+    while (!run && steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(milliseconds(10));
+    }
+    scheduler->stop();
+
+    assert(run && "❌ Queued deadline not recomputed after a clock jump!");
+    assert(scheduler->get_clock_jump_count() == 1 &&
+           "❌ Clock jump not detected exactly once!");
+    std::cout << "✅ Clock jump re-anchored the queue!" << std::endl;
+}
+
 void test_delete_job()
 {
     auto scheduler = std::make_shared<ChronixScheduler>(1, 4);
@@ -215,4 +312,1810 @@ void test_pause_running_job_should_throw()
 
     scheduler->stop();
     std::cout << "✅ Task ran!" << std::endl;
-}
\ No newline at end of file
+}
+
+void test_timing_wheel_queue()
+{
+    using namespace std::chrono;
+
+    auto start = steady_clock::time_point(milliseconds(1700000000123));
+    TimingWheelJobQueue queue(start);
+
+    // 覆盖各层级以及溢出链表
+    std::vector<milliseconds> offsets{
+        milliseconds(5),         milliseconds(999),     seconds(7),
+        minutes(3) + seconds(2), hours(5),              hours(24 * 3),
+        hours(24 * 400),         milliseconds(0),       milliseconds(-20),
+    };
+    for (size_t i = 0; i != offsets.size(); i++)
+    {
+        queue.push(JobNode(i, start + offsets[i]));
+    }
+    assert(queue.size() == offsets.size() && "❌ Wheel size mismatch!");
+
+    std::vector<JobNode> out;
+    auto now = start;
+    while (!queue.empty())
+    {
+        now = std::max(now + milliseconds(1), queue.next_wake());
+        size_t before = out.size();
+        queue.pop_expired(now, out);
+        for (size_t i = before; i != out.size(); i++)
+        {
+            assert(out[i].next <= now && "❌ Wheel fired too early!");
+            assert(now - std::max(out[i].next, start) <= milliseconds(1) &&
+                   "❌ Wheel fired too late!");
+        }
+    }
+
+    assert(out.size() == offsets.size() && "❌ Wheel lost nodes!");
+    std::cout << "✅ Timing wheel expired in order!" << std::endl;
+}
+
+void test_timing_wheel_cron_job()
+{
+    auto scheduler =
+        std::make_shared<ChronixScheduler>(1, 4, JobQueueType::TimingWheel);
+
+    std::atomic<size_t> run_count{0};
+    bool run{false};
+
+    try
+    {
+        scheduler->start();
+        scheduler->add_cron_job("*/1 * * * * *", [&]() { run_count++; });
+        scheduler->add_once_job(
+            std::chrono::system_clock::now() + std::chrono::milliseconds(100),
+            [&]() { run = true; });
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(3550));
+    scheduler->stop();
+
+    assert(run && "❌ Task did not run!");
+    assert(run_count >= 3 && "❌ Task did not run!");
+    std::cout << "✅ Task ran!" << std::endl;
+}
+
+void test_job_queue_remove_and_reposition()
+{
+    using namespace std::chrono;
+
+    auto start = steady_clock::time_point(milliseconds(1700000000000));
+
+    std::vector<std::unique_ptr<JobQueue>> queues;
+    queues.emplace_back(std::make_unique<HeapJobQueue>());
+    queues.emplace_back(std::make_unique<TimingWheelJobQueue>(start));
+
+    for (auto& queue : queues)
+    {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<size_t> id_dist(0, 2000);
+        std::uniform_int_distribution<int64_t> offset_dist(0, 7200 * 1000);
+        std::uniform_int_distribution<int> op_dist(0, 9);
+
+        // 参照实现
+        std::unordered_map<size_t, steady_clock::time_point> expected;
+        auto now = start;
+
+        for (size_t step = 0; step != 50000; step++)
+        {
+            size_t id = id_dist(rng);
+            int op = op_dist(rng);
+            if (op < 6)
+            {
+                auto next = now + milliseconds(offset_dist(rng));
+                queue->push(JobNode(id, next));
+                expected[id] = next;
+            }
+            else if (op < 9)
+            {
+                bool removed = queue->remove(id);
+                assert(removed == (expected.erase(id) == 1) &&
+                       "❌ Queue remove mismatch!");
+            }
+            else
+            {
+                now += milliseconds(offset_dist(rng) / 100);
+
+                std::vector<JobNode> out;
+                queue->pop_expired(now, out);
+                for (auto& node : out)
+                {
+                    auto it = expected.find(node.id);
+                    assert(it != expected.end() && it->second == node.next &&
+                           "❌ Queue popped a stale node!");
+                    expected.erase(it);
+                }
+                for (auto& [id, next] : expected)
+                {
+                    assert(next > now && "❌ Queue missed a due node!");
+                }
+            }
+            assert(queue->size() == expected.size() &&
+                   "❌ Queue size mismatch!");
+        }
+    }
+
+    std::cout << "✅ Job queues removed and repositioned nodes!" << std::endl;
+}
+
+void test_remove_job_releases_job()
+{
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 4);
+
+    bool released{false};
+
+    try
+    {
+        scheduler->start();
+
+        // 每年执行一次
+        size_t job_id = scheduler->add_cron_job("0 0 0 1 1 *", []() {});
+        scheduler->remove_job(job_id);
+
+        try
+        {
+            scheduler->get_job_status(job_id);
+        }
+        catch (std::exception& e)
+        {
+            released = true;
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+
+    scheduler->stop();
+
+    assert(released && "❌ Removed job is still stored!");
+    std::cout << "✅ Removed job released!" << std::endl;
+}
+
+void test_sharded_scheduler()
+{
+    auto scheduler =
+        std::make_shared<ChronixScheduler>(1, 4, JobQueueType::Heap, 4);
+
+    std::atomic<size_t> run_count{0};
+    std::atomic<size_t> cron_count{0};
+
+    try
+    {
+        scheduler->start();
+
+        // 多线程并发添加任务
+        std::vector<std::thread> producers;
+        for (size_t t = 0; t != 4; t++)
+        {
+            producers.emplace_back([&]() {
+                for (size_t i = 0; i != 50; i++)
+                {
+                    scheduler->add_immediate_job([&]() { run_count++; });
+                    scheduler->add_once_job(std::chrono::system_clock::now() +
+                                                std::chrono::milliseconds(10),
+                                            [&]() { run_count++; });
+                }
+            });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+
+        size_t job_id =
+            scheduler->add_cron_job("*/1 * * * * *", [&]() { cron_count++; });
+        scheduler->pause_job(job_id);
+        assert(scheduler->get_job_status(job_id) == JobStatus::Paused &&
+               "❌ Job was not paused!");
+        scheduler->resume_job(job_id);
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2550));
+    scheduler->stop();
+
+    assert(run_count == 400 && "❌ Task did not run!");
+    assert(cron_count >= 2 && "❌ Task did not run!");
+    assert(scheduler->get_job_count() == 1 && "❌ Job count mismatch!");
+    std::cout << "✅ Sharded tasks ran!" << std::endl;
+}
+
+void test_bulk_add_jobs()
+{
+    // 批量建堆后出队顺序正确
+    HeapJobQueue queue;
+    auto base = std::chrono::steady_clock::now();
+    std::vector<JobNode> nodes;
+    for (size_t i = 0; i != 1000; i++)
+    {
+        nodes.emplace_back(
+            i, base + std::chrono::milliseconds((i * 7919) % 1000));
+    }
+    queue.push_bulk(nodes);
+    queue.push_bulk({JobNode(0, base + std::chrono::seconds(2))});
+    std::vector<JobNode> expired;
+    queue.pop_expired(base + std::chrono::seconds(3), expired);
+    assert(expired.size() == 1000 && "❌ Bulk push lost nodes!");
+    for (size_t i = 1; i != expired.size(); i++)
+    {
+        assert(expired[i - 1].next <= expired[i].next &&
+               "❌ Bulk push order mismatch!");
+    }
+    assert(expired.back().id == 0 && "❌ Bulk push did not update node!");
+
+    auto scheduler =
+        std::make_shared<ChronixScheduler>(1, 4, JobQueueType::Heap, 4);
+
+    std::atomic<size_t> run_count{0};
+
+    scheduler->add_executor_pool("bulk", 1, 1);
+
+    scheduler->start();
+
+    std::vector<ChronixScheduler::ImmediateJobSpec> tasks(
+        100, {[&]() { run_count++; }, JobPriority::High, "bulk"});
+    auto immediate_ids = scheduler->add_immediate_jobs(tasks);
+
+    std::vector<ChronixScheduler::OnceJobSpec> once;
+    for (size_t i = 0; i != 100; i++)
+    {
+        once.emplace_back(std::chrono::system_clock::now() +
+                              std::chrono::milliseconds(i),
+                          [&]() { run_count++; });
+    }
+    auto once_ids = scheduler->add_once_jobs(once);
+
+    assert(immediate_ids.size() == 100 && once_ids.size() == 100 &&
+           "❌ Bulk ids size mismatch!");
+    std::unordered_set<size_t> unique_ids(immediate_ids.begin(),
+                                          immediate_ids.end());
+    unique_ids.insert(once_ids.begin(), once_ids.end());
+    assert(unique_ids.size() == 200 && "❌ Bulk ids are not unique!");
+
+    // 任一表达式, 池名或时区非法时整体不添加
+    std::vector<ChronixScheduler::CronJobSpec> crons{
+        {"0 0 3 * * *", []() {}, JobPriority::Low,
+         ChronixScheduler::DEFAULT_POOL, "UTC"},
+        {"invalid", []() {}},
+    };
+    auto rejected = [&](ChronixScheduler::CronJobSpec spec) {
+        crons.back() = std::move(spec);
+        try
+        {
+            scheduler->add_cron_jobs(crons);
+        }
+        catch (const std::runtime_error& e)
+        {
+            return true;
+        }
+        return false;
+    };
+    assert(rejected({"invalid", []() {}}) &&
+           "❌ Invalid cron expression was accepted!");
+    assert(rejected({"0 0 3 * * *", []() {}, JobPriority::Normal, "nowhere"}) &&
+           "❌ Unknown pool was accepted!");
+    assert(rejected({"0 0 3 * * *", []() {}, JobPriority::Normal,
+                     ChronixScheduler::DEFAULT_POOL, "Nowhere/Atlantis"}) &&
+           "❌ Unknown zone was accepted!");
+
+    crons.pop_back();
+    auto cron_ids = scheduler->add_cron_jobs(crons);
+    assert(scheduler->get_job_status(cron_ids[0]) == JobStatus::Pending &&
+           "❌ Bulk cron job was not added!");
+    auto fire = scheduler->get_next_fire_times(cron_ids[0], 1);
+    assert(std::chrono::system_clock::to_time_t(fire[0]) % 86400 == 3 * 3600 &&
+           "❌ Bulk cron job ignored its zone!");
+
+    // 右值范围的任务被移走而不是复制
+    auto token = std::make_shared<int>(0);
+    std::vector<ChronixScheduler::OnceJobSpec> later;
+    for (size_t i = 0; i != 10; i++)
+    {
+        later.emplace_back(
+            std::chrono::system_clock::now() + std::chrono::hours(1),
+            [token]() {});
+    }
+    scheduler->add_once_jobs(later);
+    assert(token.use_count() == 21 && "❌ Lvalue specs were not copied!");
+    scheduler->add_once_jobs(std::move(later));
+    assert(token.use_count() == 21 && "❌ Rvalue specs were copied!");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    scheduler->stop();
+
+    assert(run_count == 200 && "❌ Task did not run!");
+    assert(scheduler->get_pool_metrics("bulk").completed == 100 &&
+           "❌ Bulk jobs ignored their pool!");
+    assert(scheduler->get_job_count() == 21 && "❌ Job count mismatch!");
+    std::cout << "✅ Bulk added tasks ran!" << std::endl;
+}
+
+void test_slot_map_stale_ids()
+{
+    SlotMap<int> slots(4, 1);
+    auto a = slots.insert(1);
+    auto b = slots.insert(2);
+    assert(static_cast<uint32_t>(a) % 4 == 1 && "❌ Slot id offset mismatch!");
+    assert(slots.erase(a) && !slots.erase(a) && "❌ Slot erase mismatch!");
+    assert(*slots.find(b) == 2 && "❌ Slot value moved incorrectly!");
+
+    // 复用槽位后旧ID失效
+    auto c = slots.insert(3);
+    assert(static_cast<uint32_t>(c) == static_cast<uint32_t>(a) &&
+           "❌ Slot was not reused!");
+    assert(slots.find(a) == nullptr && *slots.find(c) == 3 &&
+           "❌ Stale id was not detected!");
+
+    assert(slots.occupant(a) == c && slots.occupant(b) == b &&
+           "❌ Slot occupant mismatch!");
+    slots.insert_at(a, 4);
+    assert(slots.find(c) == nullptr && *slots.find(a) == 4 &&
+           slots.size() == 2 && "❌ Insert at id mismatch!");
+
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 4);
+    size_t removed = scheduler->add_cron_job("0 0 0 1 1 *", []() {});
+    scheduler->remove_job(removed);
+    size_t reused = scheduler->add_cron_job("0 0 0 1 1 *", []() {});
+
+    bool thrown = false;
+    try
+    {
+        scheduler->get_job_status(removed);
+    }
+    catch (const std::runtime_error& e)
+    {
+        thrown = true;
+    }
+    assert(thrown && reused != removed && "❌ Stale job id was accepted!");
+    assert(scheduler->get_job_status(reused) == JobStatus::Pending &&
+           "❌ Reused job id mismatch!");
+    std::cout << "✅ Stale job ids detected!" << std::endl;
+}
+
+void test_fire_groups()
+{
+    auto scheduler =
+        std::make_shared<ChronixScheduler>(1, 4, JobQueueType::Heap, 2);
+    scheduler->set_fire_groups_enabled(true);
+
+    std::atomic<size_t> run_count{0};
+    std::atomic<size_t> paused_count{0};
+
+    scheduler->start();
+
+    std::vector<ChronixScheduler::CronJobSpec> specs;
+    for (size_t i = 0; i != 1000; i++)
+    {
+        specs.emplace_back("*/1 * * * * *", [&]() { run_count++; });
+    }
+    auto ids = scheduler->add_cron_jobs(specs);
+    size_t paused =
+        scheduler->add_cron_job("*/1 * * * * *", [&]() { paused_count++; });
+    size_t yearly = scheduler->add_cron_job("0 0 0 1 1 *", []() {});
+
+    // 每个分片每个表达式一个组, 年度任务只落在一个分片
+    assert(scheduler->get_fire_group_count() == 3 &&
+           "❌ Fire group count mismatch!");
+
+    scheduler->pause_job(paused);
+    scheduler->remove_job(yearly);
+    assert(scheduler->get_fire_group_count() == 2 &&
+           "❌ Empty fire group was not released!");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2550));
+    scheduler->stop();
+
+    assert(run_count >= 2 * ids.size() && "❌ Grouped tasks did not run!");
+    assert(paused_count == 0 && "❌ Paused member was fired!");
+    assert(scheduler->get_job_count() == 1001 && "❌ Job count mismatch!");
+    std::cout << "✅ Fire groups ran!" << std::endl;
+}
+
+void test_job_counters()
+{
+    auto scheduler =
+        std::make_shared<ChronixScheduler>(1, 4, JobQueueType::Heap, 2);
+    scheduler->set_jitter(0, 0);
+
+    scheduler->start();
+
+    size_t first = scheduler->add_cron_job("0 0 0 1 1 *", []() {});
+    size_t second = scheduler->add_cron_job("0 0 0 1 1 *", []() {});
+    scheduler->add_once_job(
+        std::chrono::system_clock::now() + std::chrono::milliseconds(100),
+        []() { std::this_thread::sleep_for(std::chrono::milliseconds(300)); });
+
+    scheduler->pause_job(first);
+    assert(scheduler->get_job_count() == 3 &&
+           scheduler->get_paused_job_count() == 1 &&
+           "❌ Job counters mismatch!");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    assert(scheduler->get_running_job_count() == 1 &&
+           "❌ Running counter mismatch!");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(350));
+    scheduler->resume_job(first);
+    scheduler->remove_job(second);
+    scheduler->stop();
+
+    assert(scheduler->get_job_count() == 1 &&
+           scheduler->get_running_job_count() == 0 &&
+           scheduler->get_paused_job_count() == 0 &&
+           "❌ Job counters mismatch!");
+    std::cout << "✅ Job counters matched!" << std::endl;
+}
+
+void test_misfire_policies()
+{
+    // 单线程执行器被阻塞, 周期任务错过多次触发
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 1);
+    scheduler->set_jitter(0, 0);
+
+    std::atomic<size_t> fire_all_count{0};
+    std::atomic<size_t> fire_once_count{0};
+    std::atomic<size_t> skip_count{0};
+
+    scheduler->start();
+
+    scheduler->add_immediate_job(
+        []() { std::this_thread::sleep_for(std::chrono::milliseconds(3200)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    size_t fire_all =
+        scheduler->add_cron_job("*/1 * * * * *", [&]() { fire_all_count++; });
+    size_t fire_once =
+        scheduler->add_cron_job("*/1 * * * * *", [&]() { fire_once_count++; });
+    size_t skip =
+        scheduler->add_cron_job("*/1 * * * * *", [&]() { skip_count++; });
+    scheduler->set_misfire_policy(fire_all, MisfirePolicy::FireAll);
+    scheduler->set_misfire_policy(fire_once, MisfirePolicy::FireOnce);
+    scheduler->set_misfire_policy(skip, MisfirePolicy::Skip);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(3500));
+    scheduler->stop();
+
+    assert(scheduler->get_misfire_count() > 0 && "❌ Misfires not counted!");
+    assert(scheduler->get_job_metrics(skip).misfire_count > 0 &&
+           "❌ Job misfires not counted!");
+    assert(fire_all_count > fire_once_count &&
+           fire_once_count > skip_count && "❌ Misfire policy mismatch!");
+    std::cout << "✅ Misfire policies applied!" << std::endl;
+}
+
+void test_work_stealing_pool()
+{
+    const size_t producers = 4;
+    const size_t tasks = 10000;
+
+    std::atomic<size_t> count{0};
+    {
+        WorkStealingPool pool(4);
+        // 抛出异常的任务不影响工作线程
+        pool.post([]() { throw 1; });
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p != producers; p++)
+        {
+            threads.emplace_back([&]() {
+                for (size_t i = 0; i != tasks; i++)
+                {
+                    // 工作线程内提交的子任务进入本地队列
+                    pool.post([&]() {
+                        count++;
+                        pool.post([&]() { count++; });
+                    });
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        // failed 先于 completed 累加, completed 到齐后 failed 已确定
+        auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (pool.get_metrics().completed != producers * tasks * 2 + 1 &&
+               std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        assert(pool.get_metrics().failed == 1 && "❌ Failed task not counted!");
+    }
+    assert(count == producers * tasks * 2 && "❌ Work stealing lost tasks!");
+
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 4);
+    scheduler->set_executor(std::make_unique<WorkStealingPool>(2));
+
+    std::atomic<size_t> runs{0};
+    scheduler->start();
+    for (size_t i = 0; i != 10; i++)
+    {
+        scheduler->add_immediate_job([&]() { runs++; });
+    }
+
+    bool thrown{false};
+    try
+    {
+        scheduler->set_executor(std::make_unique<WorkStealingPool>(2));
+    }
+    catch (const std::exception&)
+    {
+        thrown = true;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(550));
+    scheduler->stop();
+
+    assert(thrown && "❌ Executor replaced while running!");
+    assert(runs == 10 && "❌ Jobs did not run on work stealing pool!");
+    std::cout << "✅ Work stealing pool ran all tasks!" << std::endl;
+}
+
+void test_elastic_thread_pool()
+{
+    ThreadPool pool(1, 4);
+    pool.set_keep_alive(std::chrono::milliseconds(200));
+
+    std::atomic<size_t> grows{0};
+    std::atomic<size_t> shrinks{0};
+    pool.set_scaling_callback([&](ScalingEvent event, size_t) {
+        (event == ScalingEvent::Grow ? grows : shrinks)++;
+    });
+
+    // 阻塞任务占满线程, 线程池扩容到上限
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i != 8; i++)
+    {
+        futures.emplace_back(pool.submit([]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }));
+    }
+    assert(pool.get_thread_count() == 4 && "❌ Thread pool did not grow!");
+
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    // 空闲超时后回收到 min_threads
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    assert(pool.get_thread_count() == 1 && "❌ Thread pool did not shrink!");
+    assert(pool.get_grow_count() == 3 && pool.get_shrink_count() == 3 &&
+           grows == 3 && shrinks == 3 && "❌ Scaling events mismatch!");
+
+    // 下一次提交时回收已退出的线程
+    pool.submit([]() {}).get();
+    std::cout << "✅ Thread pool grew and shrank!" << std::endl;
+}
+
+void test_unique_function()
+{
+    // 只能移动的捕获, 大对象存放在堆上
+    auto value = std::make_unique<int>(42);
+    std::array<char, 256> large{};
+    large[0] = 1;
+
+    unique_function<int()> small([value = std::move(value)]() {
+        return *value;
+    });
+    unique_function<int()> big([large]() { return large[0] + 1; });
+
+    unique_function<int()> moved(std::move(small));
+    assert(!small && moved && moved() == 42 && big() == 2 &&
+           "❌ unique_function call mismatch!");
+
+    bool thrown{false};
+    try
+    {
+        small();
+    }
+    catch (const std::bad_function_call&)
+    {
+        thrown = true;
+    }
+    assert(thrown && "❌ Empty unique_function did not throw!");
+
+    ThreadPool pool(1, 2);
+    std::promise<int> promise;
+    auto future = promise.get_future();
+    pool.submit_detached(
+        [](std::promise<int> p, int v) { p.set_value(v); }, std::move(promise),
+        7);
+    assert(future.get() == 7 && "❌ Detached task did not run!");
+
+    // 抛出异常的任务不影响工作线程, 计入 failed
+    pool.post([]() { throw 1; });
+    assert(pool.submit([](int v) { return v * 2; }, 21).get() == 42 &&
+           "❌ Submit result mismatch!");
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (pool.get_metrics().completed != 3 &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(pool.get_metrics().failed == 1 && "❌ Failed task not counted!");
+    std::cout << "✅ unique_function and detached submit work!" << std::endl;
+}
+
+void test_priority_lanes()
+{
+    // 单线程被阻塞, 解除后按车道顺序执行
+    ThreadPool pool(1, 1);
+    pool.set_aging(std::chrono::milliseconds(0));
+
+    std::promise<void> gate;
+    auto gate_future = gate.get_future().share();
+    pool.post([gate_future]() { gate_future.wait(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::mutex order_mutex;
+    std::vector<JobPriority> order;
+    auto record = [&](JobPriority priority) {
+        return [&, priority]() {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.emplace_back(priority);
+        };
+    };
+    for (auto priority :
+         {JobPriority::Low, JobPriority::Normal, JobPriority::High})
+    {
+        for (size_t i = 0; i != 3; i++)
+        {
+            pool.post(record(priority), priority);
+        }
+    }
+    assert(pool.get_queued_count(JobPriority::Low) == 3 &&
+           "❌ Lane depth mismatch!");
+
+    // 低优先级车道最后执行, 由它确认三条车道都已清空
+    std::promise<void> drained;
+    pool.post([&drained]() { drained.set_value(); }, JobPriority::Low);
+    gate.set_value();
+    drained.get_future().get();
+    assert(order.size() == 9 &&
+           std::is_sorted(order.begin(), order.end(),
+                          [](JobPriority a, JobPriority b) { return a > b; }) &&
+           "❌ Lanes not served by priority!");
+
+    // 低优先级任务等待两个老化周期后排在新的高优先级任务之前
+    pool.set_aging(std::chrono::milliseconds(50));
+    std::promise<void> block;
+    auto block_future = block.get_future().share();
+    pool.post([block_future]() { block_future.wait(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    order.clear();
+    pool.post(record(JobPriority::Low), JobPriority::Low);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    pool.post(record(JobPriority::High), JobPriority::High);
+
+    block.set_value();
+    pool.submit([]() {}).get();
+    assert(order.size() == 2 && order.front() == JobPriority::Low &&
+           "❌ Aged task was starved!");
+
+    // 调度器按任务优先级投递
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 2);
+    std::atomic<bool> run{false};
+    scheduler->start();
+    scheduler->add_immediate_job([&]() { run = true; }, JobPriority::High);
+    std::this_thread::sleep_for(std::chrono::milliseconds(550));
+    scheduler->stop();
+    assert(run && "❌ Prioritized job did not run!");
+    std::cout << "✅ Priority lanes served in order with aging!" << std::endl;
+}
+
+void test_executor_pools()
+{
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 2);
+    scheduler->set_jitter(0, 0);
+    scheduler->add_executor_pool("slow", 1, 1, 1);
+
+    std::atomic<size_t> slow_runs{0};
+    std::atomic<size_t> fast_runs{0};
+
+    scheduler->start();
+
+    // 慢任务占满隔离池, 第三个任务因队列已满被拒绝
+    for (size_t i = 0; i != 3; i++)
+    {
+        scheduler->add_immediate_job(
+            [&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                slow_runs++;
+            },
+            JobPriority::Normal, "slow");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    for (size_t i = 0; i != 5; i++)
+    {
+        scheduler->add_immediate_job([&]() { fast_runs++; });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(fast_runs == 5 && slow_runs == 0 &&
+           "❌ Default pool was blocked by slow pool!");
+
+    auto metrics = scheduler->get_pool_metrics("slow");
+    assert(metrics.threads == 1 && metrics.active_threads == 1 &&
+           metrics.rejected == 1 && metrics.utilization() == 1.0 &&
+           "❌ Pool metrics mismatch!");
+
+    bool thrown{false};
+    try
+    {
+        scheduler->add_immediate_job([]() {}, JobPriority::Normal, "none");
+    }
+    catch (const std::exception&)
+    {
+        thrown = true;
+    }
+    assert(thrown && "❌ Unknown pool accepted!");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    scheduler->stop();
+
+    assert(slow_runs == 2 && "❌ Slow pool runs mismatch!");
+    assert(scheduler->get_pool_names().size() == 2 &&
+           scheduler->get_pool_metrics(ChronixScheduler::DEFAULT_POOL)
+                   .completed >= 5 &&
+           "❌ Default pool metrics mismatch!");
+    std::cout << "✅ Executor pools isolated slow jobs!" << std::endl;
+}
+
+void test_bounded_queue_policies()
+{
+    // 阻塞唯一的工作线程, 队列上限为 2
+    auto run_full = [](QueueFullPolicy policy, auto&& third) {
+        auto pool = std::make_unique<ThreadPool>(1, 1);
+        pool->set_max_queue(2, policy);
+
+        auto gate = std::make_shared<std::promise<void>>();
+        auto gate_future = gate->get_future().share();
+        pool->post([gate_future]() { gate_future.wait(); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        pool->post([]() {}, JobPriority::Low);
+        pool->post([]() {}, JobPriority::High);
+        third(*pool, *gate);
+        while (pool->get_queue_depth() != 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return pool;
+    };
+
+    auto pool = run_full(QueueFullPolicy::Reject,
+                         [](ThreadPool& p, std::promise<void>& gate) {
+                             bool thrown{false};
+                             try
+                             {
+                                 p.post([]() {});
+                             }
+                             catch (const std::exception&)
+                             {
+                                 thrown = true;
+                             }
+                             assert(thrown && p.get_queue_depth() == 2 &&
+                                    "❌ Full queue did not reject!");
+                             gate.set_value();
+                         });
+    assert(pool->get_metrics().rejected == 1 && "❌ Rejections not counted!");
+
+    pool = run_full(QueueFullPolicy::DropOldest,
+                    [](ThreadPool& p, std::promise<void>& gate) {
+                        p.post([]() {});
+                        assert(p.get_queued_count(JobPriority::Low) == 0 &&
+                               p.get_queue_depth() == 2 &&
+                               "❌ Oldest low task was not dropped!");
+                        gate.set_value();
+                    });
+    assert(pool->get_metrics().dropped == 1 && "❌ Drops not counted!");
+
+    pool = run_full(QueueFullPolicy::CallerRuns,
+                    [](ThreadPool& p, std::promise<void>& gate) {
+                        auto caller = std::this_thread::get_id();
+                        std::thread::id runner;
+                        p.post([&]() { runner = std::this_thread::get_id(); });
+                        assert(runner == caller &&
+                               "❌ Task did not run on the caller!");
+                        gate.set_value();
+                    });
+    assert(pool->get_metrics().caller_runs == 1 &&
+           "❌ Caller runs not counted!");
+
+    pool = run_full(QueueFullPolicy::Block,
+                    [](ThreadPool& p, std::promise<void>& gate) {
+                        std::atomic<bool> posted{false};
+                        std::thread submitter([&]() {
+                            p.post([]() {});
+                            posted = true;
+                        });
+                        std::this_thread::sleep_for(
+                            std::chrono::milliseconds(100));
+                        assert(!posted && "❌ Full queue did not block!");
+                        gate.set_value();
+                        submitter.join();
+                        assert(posted && "❌ Blocked post never resumed!");
+                    });
+    assert(pool->get_metrics().blocked == 1 && "❌ Blocks not counted!");
+
+    // 工作线程向自己所在的满队列投递时不等待, 超出上限入队
+    ThreadPool self_pool(1, 1);
+    self_pool.set_max_queue(1, QueueFullPolicy::Block);
+    std::atomic<size_t> nested{0};
+    auto fanned_out = self_pool.submit([&]() {
+        for (size_t i = 0; i != 3; i++)
+        {
+            self_pool.post([&]() { nested++; });
+        }
+        std::vector<std::function<void()>> bulk(3, [&]() { nested++; });
+        self_pool.submit_bulk(bulk);
+    });
+    assert(fanned_out.wait_for(std::chrono::seconds(2)) ==
+               std::future_status::ready &&
+           "❌ Worker blocked on its own full queue!");
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (nested != 6 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(nested == 6 && self_pool.get_metrics().blocked == 0 &&
+           "❌ Self posts past the limit were lost!");
+
+    // 被丢弃的调度任务按失败结束, 不会一直处于运行状态
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 2);
+    scheduler->set_jitter(0, 0);
+    scheduler->set_metrics_enabled(true);
+    scheduler->add_executor_pool("bounded", 1, 1, 1,
+                                 QueueFullPolicy::DropOldest);
+    scheduler->start();
+
+    std::atomic<size_t> runs{0};
+    auto slow = [&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        runs++;
+    };
+    for (size_t i = 0; i != 4; i++)
+    {
+        scheduler->add_immediate_job(slow, JobPriority::Normal, "bounded");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(800));
+    scheduler->stop();
+
+    assert(runs == 2 && scheduler->get_pool_metrics("bounded").dropped == 2 &&
+           "❌ Scheduler drops mismatch!");
+    assert(scheduler->get_running_job_count() == 0 &&
+           scheduler->get_job_count() == 0 &&
+           "❌ Dropped run left a job behind!");
+    std::cout << "✅ Bounded queue policies applied!" << std::endl;
+}
+
+void test_submit_bulk()
+{
+    ThreadPool pool(2, 8);
+    std::atomic<size_t> count{0};
+    std::vector<std::function<void()>> tasks(1000, [&]() { count++; });
+    pool.submit_bulk(tasks, JobPriority::High);
+    while (pool.get_metrics().completed != 1000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(count == 1000 && "❌ Bulk tasks lost!");
+
+    // 超出上限的部分被拒绝并留给调用者
+    ThreadPool bounded(1, 1);
+    bounded.set_max_queue(4);
+    auto gate = std::make_shared<std::promise<void>>();
+    auto gate_future = gate->get_future().share();
+    bounded.post([gate_future]() { gate_future.wait(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::vector<unique_function<void()>> batch;
+    for (size_t i = 0; i != 10; i++)
+    {
+        batch.emplace_back([]() {});
+    }
+    bool thrown{false};
+    try
+    {
+        bounded.post_bulk(batch, JobPriority::Normal);
+    }
+    catch (const std::exception&)
+    {
+        thrown = true;
+    }
+    assert(thrown && bounded.get_queue_depth() == 4 &&
+           bounded.get_metrics().rejected == 6 &&
+           "❌ Bulk overflow not rejected!");
+    gate->set_value();
+
+    // 同一时刻到期的任务整批投递
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 4);
+    scheduler->set_jitter(0, 0);
+    scheduler->start();
+    std::atomic<size_t> runs{0};
+    auto at = std::chrono::system_clock::now() + std::chrono::milliseconds(200);
+    for (size_t i = 0; i != 100; i++)
+    {
+        scheduler->add_once_job(at, [&]() { runs++; });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    scheduler->stop();
+    assert(runs == 100 && "❌ Batched runs lost!");
+    std::cout << "✅ Bulk submission enqueued under one lock!" << std::endl;
+}
+
+void test_worker_wait()
+{
+    ThreadPool pool(2, 4);
+    pool.set_keep_alive(std::chrono::milliseconds(200));
+    pool.set_worker_wait(
+        {std::chrono::microseconds(200), std::chrono::microseconds(200)});
+    assert(pool.get_worker_wait().spin.count() == 200 &&
+           "❌ Worker wait not stored!");
+
+    // 间隔小于自旋时间的任务由自旋线程取走, 不会丢失唤醒
+    std::atomic<size_t> count{0};
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p != 4; p++)
+    {
+        producers.emplace_back([&]() {
+            for (size_t i = 0; i != 2000; i++)
+            {
+                pool.post([&]() { count++; });
+                if (i % 100 == 0)
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    while (pool.get_metrics().completed != 8000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(count == 8000 && "❌ Spinning workers lost tasks!");
+
+    // 空闲后扩出的线程仍被回收, 休眠的线程仍能被唤醒
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    assert(pool.get_thread_count() == 2 && "❌ Idle workers not reaped!");
+    auto done = pool.submit([]() { return 42; });
+    assert(done.get() == 42 && "❌ Parked worker not woken!");
+    std::cout << "✅ Workers spin, yield, then park!" << std::endl;
+}
+
+void test_cpu_affinity()
+{
+    assert(parse_cpu_list("0-2, 5,3") ==
+               std::vector<size_t>({0, 1, 2, 3, 5}) &&
+           "❌ Cpu list parsed wrong!");
+    bool thrown{false};
+    try
+    {
+        parse_cpu_list("3-1");
+    }
+    catch (const std::exception&)
+    {
+        thrown = true;
+    }
+    assert(thrown && "❌ Bad cpu list accepted!");
+
+    auto nodes = numa_nodes();
+    assert(!nodes.empty() && !nodes.front().cpus.empty() &&
+           "❌ No NUMA node found!");
+
+#ifdef __linux__
+    // 绑定到主线程所在的核心, 工作线程只能在该核心上运行
+    size_t target = static_cast<size_t>(sched_getcpu());
+    ThreadPool pool(2, 2);
+    pool.set_cpu_affinity({target});
+    for (size_t i = 0; i != 4; i++)
+    {
+        auto cpu = pool.submit([]() { return sched_getcpu(); });
+        assert(static_cast<size_t>(cpu.get()) == target &&
+               "❌ Worker not pinned!");
+    }
+#endif
+
+    // 工作线程派生的任务留在本节点
+    NumaPool numa(1, 2);
+    assert(numa.get_node_count() == nodes.size() &&
+           numa.get_thread_count() == nodes.size() &&
+           "❌ One pool per node expected!");
+
+    std::atomic<size_t> count{0};
+    std::atomic<bool> local{true};
+    for (size_t i = 0; i != 100; i++)
+    {
+        numa.post([&]() {
+            ThreadPool* self = ThreadPool::current();
+            numa.post([&, self]() {
+                local = local && ThreadPool::current() == self;
+                count++;
+            });
+            count++;
+        });
+    }
+    std::vector<unique_function<void()>> batch;
+    for (size_t i = 0; i != 100; i++)
+    {
+        batch.emplace_back([&]() { count++; });
+    }
+    numa.post_bulk(batch, JobPriority::Normal);
+    while (count != 300)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(local && batch.empty() && "❌ Task left its node!");
+
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 2);
+    scheduler->set_jitter(0, 0);
+    scheduler->set_executor(std::make_unique<NumaPool>(1, 2));
+    scheduler->set_dispatcher_affinity({nodes.front().cpus.front()});
+    scheduler->start();
+    std::atomic<bool> ran{false};
+    scheduler->add_immediate_job([&]() { ran = true; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    scheduler->stop();
+    assert(ran && "❌ Pinned dispatcher did not run the job!");
+    std::cout << "✅ Workers and dispatcher pinned per NUMA node!"
+              << std::endl;
+}
+
+#ifdef CHRONIX_COROUTINES
+void test_async_jobs()
+{
+    // 两个工作线程承载上千个同时挂起的协程任务
+    auto scheduler = std::make_shared<ChronixScheduler>(2, 2);
+    scheduler->set_jitter(0, 0);
+    scheduler->start();
+
+    std::atomic<size_t> woke{0};
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != 1000; i++)
+    {
+        scheduler->add_immediate_job_async([&]() -> AsyncTask {
+            co_await async_sleep_for(std::chrono::milliseconds(300));
+            woke++;
+        });
+    }
+    while (woke != 1000 &&
+           std::chrono::steady_clock::now() - begin < std::chrono::seconds(5))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(woke == 1000 && scheduler->get_thread_count() == 2 &&
+           std::chrono::steady_clock::now() - begin <
+               std::chrono::seconds(2) &&
+           "❌ Suspended jobs held workers!");
+
+    // 嵌套协程的异常传给外层并走错误回调
+    auto inner = []() -> AsyncTask {
+        co_await async_sleep_for(std::chrono::milliseconds(10));
+        throw std::runtime_error("inner failed");
+    };
+    std::atomic<bool> failed{false};
+    size_t once_id = scheduler->add_once_job_async(
+        std::chrono::system_clock::now() + std::chrono::milliseconds(200),
+        [inner]() -> AsyncTask { co_await inner(); });
+    scheduler->set_error_callback(
+        once_id, [&](size_t, const std::exception& e) {
+            failed = std::string(e.what()) == "inner failed";
+        });
+
+    // 外部回调恢复协程, 之后在线程池中继续
+    std::thread reactor;
+    std::atomic<bool> bridged{false};
+    scheduler->add_immediate_job_async([&]() -> AsyncTask {
+        co_await async_resume_when([&](AsyncResume resume) {
+            reactor = std::thread([resume]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                resume();
+            });
+        });
+        bridged = true;
+    });
+
+    // start 返回前协程已在另一个工作线程结束, start 自身仍然有效
+    std::atomic<bool> finished{false};
+    std::atomic<bool> captures_alive{false};
+    struct EarlyResume
+    {
+        std::shared_ptr<int> probe;
+        std::atomic<bool>* finished;
+        std::atomic<bool>* captures_alive;
+
+        void operator()(AsyncResume resume)
+        {
+            std::weak_ptr<int> weak = probe;
+            std::thread([resume]() { resume(); }).join();
+            auto deadline =
+                std::chrono::steady_clock::now() + std::chrono::seconds(1);
+            while (!*finished && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            *captures_alive = !weak.expired();
+        }
+    };
+    scheduler->add_immediate_job_async([&]() -> AsyncTask {
+        // GCC 12 会按位复制 co_await 操作数中的聚合临时对象, 先具名构造
+        EarlyResume start{std::make_shared<int>(0), &finished,
+                          &captures_alive};
+        co_await async_resume_when(std::move(start));
+        finished = true;
+    });
+
+    std::atomic<size_t> cron_runs{0};
+    scheduler->add_cron_job_async("*/1 * * * * *", [&]() -> AsyncTask {
+        co_await async_sleep_for(std::chrono::milliseconds(100));
+        cron_runs++;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    reactor.join();
+    assert(failed && "❌ Nested coroutine error lost!");
+    assert(bridged && "❌ Callback did not resume the job!");
+    assert(finished && captures_alive &&
+           "❌ Resume starter outlived by its captures!");
+    assert(cron_runs >= 1 && scheduler->get_running_job_count() <= 1 &&
+           "❌ Async cron job did not run!");
+
+    // 析构时挂起的任务带着错误恢复, 不会悬空
+    std::atomic<bool> cancelled{false};
+    scheduler->add_immediate_job_async([&]() -> AsyncTask {
+        try
+        {
+            co_await async_sleep_for(std::chrono::seconds(30));
+        }
+        catch (const std::exception&)
+        {
+            cancelled = true;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(scheduler->get_suspended_job_count() >= 1 &&
+           "❌ Job not suspended on the timer!");
+    scheduler.reset();
+    assert(cancelled && "❌ Suspended job not cancelled on shutdown!");
+
+    // 执行器拒绝恢复时任务失败, 协程不在定时器线程上继续
+    auto saturated = std::make_shared<ChronixScheduler>(1, 1);
+    saturated->set_jitter(0, 0);
+    saturated->add_executor_pool("tight", 1, 1, 1, QueueFullPolicy::Reject);
+    saturated->start();
+
+    std::atomic<bool> resumed{false};
+    std::atomic<bool> rejected{false};
+    size_t sleeper = saturated->add_once_job_async(
+        std::chrono::system_clock::now() + std::chrono::milliseconds(100),
+        [&]() -> AsyncTask {
+            co_await async_sleep_for(std::chrono::milliseconds(200));
+            resumed = true;
+        },
+        JobPriority::Normal, "tight");
+    saturated->set_error_callback(
+        sleeper, [&](size_t, const std::exception& e) {
+            rejected = dynamic_cast<const ResumeRejected*>(&e) != nullptr;
+        });
+    auto begin_wait = std::chrono::steady_clock::now();
+    while (saturated->get_suspended_job_count() == 0 &&
+           std::chrono::steady_clock::now() - begin_wait <
+               std::chrono::seconds(2))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    // 唯一的工作线程被占用, 唯一的队列槽位被占满
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    saturated->add_immediate_job([released]() { released.wait(); },
+                                 JobPriority::Normal, "tight");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    saturated->add_immediate_job([]() {}, JobPriority::Normal, "tight");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    assert(rejected && !resumed &&
+           "❌ Rejected resumption ran on the timer thread!");
+    release.set_value();
+    saturated.reset();
+    std::cout << "✅ Coroutine jobs suspend off the workers!" << std::endl;
+}
+#endif
+
+// 在作用域内替换进程时区 TZ, 断言失败退出时也会还原
+class ScopedTz
+{
+public:
+    explicit ScopedTz(const char* tz)
+    {
+        const char* old_tz = std::getenv("TZ");
+        saved = old_tz != nullptr;
+        saved_tz = saved ? old_tz : "";
+        set(tz);
+    }
+
+    ScopedTz(const ScopedTz&) = delete;
+    ScopedTz& operator=(const ScopedTz&) = delete;
+
+    ~ScopedTz()
+    {
+        set(saved ? saved_tz.c_str() : nullptr);
+    }
+
+private:
+    static void set(const char* tz)
+    {
+#ifdef _WIN32
+        _putenv_s("TZ", tz ? tz : "");
+        _tzset();
+#else
+        tz ? setenv("TZ", tz, 1) : unsetenv("TZ");
+        tzset();
+#endif
+    }
+
+    bool saved;
+    std::string saved_tz;
+};
+
+void test_cron_next_closed_form()
+{
+    // 朴素实现按整天推进, 比较固定在 UTC 下进行
+    ScopedTz utc("UTC0");
+
+    assert(cron::detail::days_from_civil(1970, 1, 1) == 0 &&
+           cron::detail::days_from_civil(2000, 3, 1) == 11017 &&
+           "❌ Days from civil date wrong!");
+    auto eve = cron::detail::civil_from_days(-1);
+    assert(eve.year == 1969 && eve.month == 12 && eve.day == 31 &&
+           cron::detail::weekday_from_days(-1) == 3 &&
+           "❌ Civil date from days wrong!");
+
+    std::mt19937 rng(20210);
+    auto field = [&](int low, int high) {
+        std::uniform_int_distribution<int> kind(0, 4), value(low, high);
+        int a = value(rng), b = value(rng);
+        if (a > b)
+        {
+            std::swap(a, b);
+        }
+        switch (kind(rng))
+        {
+        case 0:
+            return std::string("*");
+        case 1:
+            return "*/" + std::to_string(value(rng) % 7 + 1);
+        case 2:
+            return std::to_string(a) + "-" + std::to_string(b);
+        case 3:
+            return std::to_string(a) + "," + std::to_string(b);
+        default:
+            return std::to_string(a) + "-" + std::to_string(b) + "/" +
+                   std::to_string(value(rng) % 3 + 1);
+        }
+    };
+
+    // 逐日扫描的朴素实现, 作为最早触发时间的基准
+    auto brute_force = [](const std::vector<std::string>& fields,
+                          std::time_t from) {
+        std::bitset<60> seconds, minutes;
+        std::bitset<24> hours;
+        std::bitset<31> days_of_month;
+        std::bitset<12> months;
+        std::bitset<7> days_of_week;
+        cron::detail::set_cron_field(fields[0], seconds, 0, 59);
+        cron::detail::set_cron_field(fields[1], minutes, 0, 59);
+        cron::detail::set_cron_field(fields[2], hours, 0, 23);
+        cron::detail::set_cron_field(fields[3], days_of_month, 1, 31);
+        cron::detail::set_cron_field(fields[4], months, 1, 12);
+        cron::detail::set_cron_field(fields[5], days_of_week, 0, 6);
+
+        std::tm start;
+        cron::utils::time_to_tm(&from, &start);
+        for (std::time_t day = from - from % 86400;; day += 86400)
+        {
+            std::tm date;
+            cron::utils::time_to_tm(&day, &date);
+            if (date.tm_year - start.tm_year > 4)
+            {
+                return cron::INVALID_TIME;
+            }
+            if (!months.test(date.tm_mon) ||
+                !days_of_month.test(date.tm_mday - 1) ||
+                !days_of_week.test(date.tm_wday))
+            {
+                continue;
+            }
+            for (int second = 0; second < 86400; second++)
+            {
+                if (day + second > from && hours.test(second / 3600) &&
+                    minutes.test(second / 60 % 60) &&
+                    seconds.test(second % 60))
+                {
+                    return day + second;
+                }
+            }
+        }
+    };
+
+    std::uniform_int_distribution<std::time_t> when(946684800, 2051222400);
+    const size_t rounds{2000};
+    for (size_t i = 0; i != rounds; i++)
+    {
+        std::vector<std::string> fields{field(0, 59), field(0, 59),
+                                        field(0, 23), field(1, 31),
+                                        field(1, 12), field(0, 6)};
+        std::string expr = fields[0];
+        for (size_t f = 1; f != fields.size(); f++)
+        {
+            expr += " " + fields[f];
+        }
+        auto cex = cron::make_cron(expr);
+        std::time_t from = when(rng);
+
+        std::time_t fast = cron::cron_next(cex, from);
+        assert(fast == brute_force(fields, from) &&
+               "❌ Closed-form cron_next missed the earliest fire time!");
+
+        std::tm date;
+        cron::utils::time_to_tm(&from, &date);
+        std::tm next = cron::cron_next(cex, date);
+        std::time_t from_tm = next.tm_mday == 0
+                                  ? cron::INVALID_TIME
+                                  : cron::utils::tm_to_time(next);
+        assert(from_tm == fast && "❌ std::tm cron_next disagrees!");
+    }
+
+    // 闰日、月末、十三号星期五和不可能的日期
+    auto at = [](const char* text) {
+        std::tm date = cron::utils::to_tm(text);
+        return cron::utils::tm_to_time(date);
+    };
+    auto next = [&](const char* expr, const char* from) {
+        return cron::cron_next(cron::make_cron(expr), at(from));
+    };
+    assert(next("0 0 0 29 2 *", "2025-03-01 00:00:00") ==
+               at("2028-02-29 00:00:00") &&
+           "❌ Leap day missed!");
+    assert(next("0 0 0 31 * *", "2026-04-01 00:00:00") ==
+               at("2026-05-31 00:00:00") &&
+           "❌ Month end missed!");
+    assert(next("0 0 12 13 * FRI", "2026-01-01 00:00:00") ==
+               at("2026-02-13 12:00:00") &&
+           "❌ Friday 13th missed!");
+    assert(next("59 59 23 31 12 *", "2026-12-31 23:59:59") ==
+               at("2027-12-31 23:59:59") &&
+           "❌ Year rollover missed!");
+    assert(next("0 0 0 30 2 *", "2026-01-01 00:00:00") ==
+               cron::INVALID_TIME &&
+           "❌ Impossible date matched!");
+
+    std::cout << "✅ Closed-form cron_next matches the brute force!"
+              << std::endl;
+}
+
+void test_time_zones()
+{
+    auto at = [](int64_t year, unsigned month, unsigned day, unsigned hour,
+                 unsigned minute) {
+        return cron::detail::civil_to_seconds(
+            {year, month, day, hour, minute, 0});
+    };
+
+    // 纯规则时区不依赖 zoneinfo 文件
+    auto new_york =
+        TimeZone::from_posix("New_York", "EST5EDT,M3.2.0,M11.1.0");
+    assert(new_york->offset_at(at(2026, 1, 15, 12, 0)) == -5 * 3600 &&
+           new_york->offset_at(at(2026, 7, 15, 12, 0)) == -4 * 3600 &&
+           "❌ POSIX rule offset wrong!");
+    assert(new_york->to_utc(at(2026, 3, 8, 2, 30)) == at(2026, 3, 8, 7, 30) &&
+           "❌ Skipped local time not moved forward by the gap!");
+    assert(new_york->to_utc(at(2026, 11, 1, 1, 30)) ==
+               at(2026, 11, 1, 5, 30) &&
+           new_york->to_utc(at(2026, 11, 1, 1, 30), true) ==
+               at(2026, 11, 1, 6, 30) &&
+           "❌ Repeated local time resolved wrong!");
+
+    // 回拨重复的一小时只触发一次, 跳过的一小时顺延一小时触发
+    auto half_past = cron::make_cron("0 30 * * * *");
+    std::time_t first = cron::cron_next(
+        half_past, static_cast<std::time_t>(at(2026, 11, 1, 4, 40)),
+        *new_york);
+    assert(first == at(2026, 11, 1, 5, 30) &&
+           cron::cron_next(half_past, first, *new_york) ==
+               at(2026, 11, 1, 7, 30) &&
+           "❌ Repeated hour fired twice!");
+    auto two_thirty = cron::make_cron("0 30 2 * * *");
+    assert(cron::cron_next(two_thirty,
+                           static_cast<std::time_t>(at(2026, 3, 8, 5, 0)),
+                           *new_york) == at(2026, 3, 8, 7, 30) &&
+           "❌ Skipped hour not moved forward by the gap!");
+
+    auto shanghai = TimeZone::from_posix("Shanghai", "CST-8");
+    auto nine = cron::make_cron("0 0 9 * * *");
+    assert(cron::cron_next(nine,
+                           static_cast<std::time_t>(at(2026, 6, 1, 0, 0)),
+                           *shanghai) == at(2026, 6, 1, 1, 0) &&
+           "❌ Fixed offset zone wrong!");
+
+    // zoneinfo 文件可用时与规则和 libc 对照
+    bool zoneinfo{true};
+    try
+    {
+        auto file = TimeZone::locate("America/New_York");
+        assert(file == TimeZone::locate("America/New_York") &&
+               "❌ Zone loaded twice!");
+        // 2007 年起美国沿用当前规则
+        for (int64_t t = at(2008, 1, 1, 0, 0); t < at(2040, 1, 1, 0, 0);
+             t += 86400 * 7 + 3600)
+        {
+            assert(file->offset_at(t) == new_york->offset_at(t) &&
+                   "❌ TZif transitions disagree with the POSIX rule!");
+        }
+    }
+    catch (const std::runtime_error&)
+    {
+        zoneinfo = false;
+    }
+
+    bool thrown{false};
+    try
+    {
+        TimeZone::locate("Nowhere/Atlantis");
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown && "❌ Unknown zone accepted!");
+
+    // 同一表达式在不同时区各成一组, 各自按时区触发
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 4);
+    scheduler->set_fire_groups_enabled(true);
+    scheduler->set_time_zone("UTC");
+    assert(scheduler->get_time_zone() == "UTC" && "❌ Default zone not set!");
+    std::atomic<size_t> utc_count{0};
+    std::atomic<size_t> india_count{0};
+    scheduler->add_cron_job("*/1 * * * * *", [&]() { utc_count++; });
+    scheduler->add_cron_job("*/1 * * * * *", [&]() { utc_count++; });
+    if (zoneinfo)
+    {
+        scheduler->add_cron_job(
+            "*/1 * * * * *", [&]() { india_count++; }, JobPriority::Normal,
+            ChronixScheduler::DEFAULT_POOL, "Asia/Kolkata");
+        assert(scheduler->get_fire_group_count() == 2 &&
+               "❌ Jobs in different zones share a group!");
+    }
+    scheduler->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2500));
+    scheduler->stop();
+    assert(utc_count >= 2 && (!zoneinfo || india_count >= 1) &&
+           "❌ Zoned cron job did not run!");
+    std::cout << "✅ Time zones convert without libc!" << std::endl;
+}
+
+void test_cron_enumeration()
+{
+    using time_point = std::chrono::system_clock::time_point;
+    auto at = [](int64_t year, unsigned month, unsigned day) {
+        return std::chrono::system_clock::from_time_t(static_cast<std::time_t>(
+            cron::detail::civil_to_seconds({year, month, day, 0, 0, 0})));
+    };
+
+    // 逐次调用 cron_next 作为基准, 覆盖夏令时切换的两个方向
+    auto chained = [](const cron::cronexpr& expr, time_point from, size_t n,
+                      auto next) {
+        std::vector<time_point> times;
+        for (auto fire = next(expr, from); times.size() < n &&
+             fire != std::chrono::system_clock::from_time_t(cron::INVALID_TIME);
+             fire = next(expr, fire))
+        {
+            times.emplace_back(fire);
+        }
+        return times;
+    };
+
+    auto new_york =
+        TimeZone::from_posix("New_York", "EST5EDT,M3.2.0,M11.1.0");
+    {
+        // 进程时区与 new_york 相同, 两种重载结果可直接比较
+        ScopedTz eastern("EST5EDT,M3.2.0,M11.1.0");
+        for (const char* text :
+             {"0 */10 * * * *", "0 30 * * * *", "0 30 2 * * *",
+              "*/7 */13 1-3 * * *", "0 0 12 13 * FRI", "0 0 0 29 2 *"})
+        {
+            auto expr = cron::make_cron(text);
+            for (auto from : {at(2026, 3, 7), at(2026, 10, 31)})
+            {
+                auto zoned =
+                    chained(expr, from, 300, [&](const auto& e, auto t) {
+                        return cron::cron_next(e, t, *new_york);
+                    });
+                std::vector<time_point> batch;
+                cron::cron_next_n(expr, from, 300, std::back_inserter(batch),
+                                  *new_york);
+                assert(batch == zoned &&
+                       "❌ cron_next_n differs from cron_next!");
+
+                std::vector<time_point> range;
+                for (auto fire :
+                     cron::cron_between(expr, from, zoned.back(), *new_york))
+                {
+                    range.emplace_back(fire);
+                }
+                assert(range == zoned &&
+                       "❌ cron_between differs from cron_next!");
+
+                auto local =
+                    chained(expr, from, 300, [](const auto& e, auto t) {
+                        return cron::cron_next(e, t);
+                    });
+                batch.clear();
+                cron::cron_next_n(expr, from, 300,
+                                  std::back_inserter(batch));
+                assert(batch == local && "❌ cron_next_n differs from "
+                                         "cron_next in the process zone!");
+            }
+        }
+    }
+
+    auto never = cron::make_cron("0 0 0 30 2 *");
+    std::vector<time_point> none;
+    cron::cron_next_n(never, at(2026, 1, 1), 10, std::back_inserter(none),
+                      *new_york);
+    auto daily = cron::make_cron("0 0 0 * * *");
+    for (auto fire : cron::cron_between(daily, at(2026, 2, 1), at(2026, 1, 1),
+                                        *new_york))
+    {
+        none.emplace_back(fire);
+    }
+    assert(none.empty() && "❌ Empty enumeration produced fire times!");
+
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 4);
+    scheduler->set_time_zone("UTC");
+    size_t cron_id = scheduler->add_cron_job("0 0 12 * * *", []() {});
+    size_t once_id = scheduler->add_once_job(
+        std::chrono::system_clock::now() + std::chrono::hours(1), []() {});
+    size_t immediate_id = scheduler->add_immediate_job([]() {});
+
+    auto times = scheduler->get_next_fire_times(cron_id, 5);
+    assert(times.size() == 5 && times[0] > std::chrono::system_clock::now() &&
+           "❌ Next fire times missing!");
+    for (size_t i = 0; i != times.size(); i++)
+    {
+        assert(std::chrono::system_clock::to_time_t(times[i]) % 86400 ==
+                   12 * 3600 &&
+               (i == 0 || times[i] - times[i - 1] == std::chrono::hours(24)) &&
+               "❌ Next fire times wrong!");
+    }
+    assert(scheduler->get_next_fire_times(once_id, 5).size() == 1 &&
+           scheduler->get_next_fire_times(immediate_id, 5).empty() &&
+           scheduler->get_next_fire_times(cron_id, 0).empty() &&
+           "❌ Next fire times of other jobs wrong!");
+
+    scheduler->remove_job(once_id);
+    bool thrown{false};
+    try
+    {
+        scheduler->get_next_fire_times(once_id, 1);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown && "❌ Unknown job accepted!");
+    std::cout << "✅ Fire times enumerate in one calendar walk!" << std::endl;
+}
+
+// 表达式在编译期解析, 非法字面量无法通过编译
+static_assert(cron::is_valid_cron("0 30 9 ? jan-Mar MON-FRI"),
+              "❌ Valid cron literal rejected!");
+static_assert(!cron::is_valid_cron("0 60 * * * *") &&
+                  !cron::is_valid_cron("0 0 * * *"),
+              "❌ Invalid cron literal accepted!");
+
+void test_cron_parser()
+{
+#if __cplusplus >= 202002L
+    constexpr cron::cron_literal friday = "0 0 12 13 * FRI";
+    static_assert(friday.fields.days_of_week == (1u << 5) &&
+                      friday.fields.days_of_month == (1u << 12),
+                  "❌ Cron literal parsed wrong!");
+    assert(friday.to_cronexpr() == cron::make_cron("0 0 12 13 * 5") &&
+           cron::to_cronstr(friday.to_cronexpr()) == "0 0 12 13 * FRI" &&
+           "❌ Cron literal differs from make_cron!");
+#endif
+
+    assert(cron::make_cron("5/15 1-10/3 */4 ? JAN,mar,DEC SUN") ==
+               cron::make_cron("5,20,35,50 1,4,7,10 0,4,8,12,16,20 * 1,3,12 0") &&
+           "❌ Cron field syntax parsed wrong!");
+    assert(cron::make_cron<cron::cron_quartz_traits>("0 0 0 * * SUN") ==
+               cron::make_cron<cron::cron_quartz_traits>("0 0 0 * * 1") &&
+           cron::make_cron<cron::cron_oracle_traits>("0 0 0 * JAN *") ==
+               cron::make_cron<cron::cron_oracle_traits>("0 0 0 * 0 *") &&
+           "❌ Names ignore the traits!");
+
+    for (const char* invalid : {"", "   ", "0 0 0 * * 1,", "0 0 0 * * 1,,2",
+                                "1-2-3 * * * * *", "*/ * * * * *",
+                                "*/0 * * * * *", "0 0 0 * * 7", "x * * * * *",
+                                "0 0 0 0 * *", "0 0 0 0 * * * *"})
+    {
+        bool thrown{false};
+        try
+        {
+            cron::make_cron(invalid);
+        }
+        catch (const cron::bad_cronexpr&)
+        {
+            thrown = true;
+        }
+        assert(thrown && "❌ Invalid cron expression accepted!");
+    }
+
+    // 最近最少使用的表达式先被淘汰
+    CronCache cache(2);
+    cache.get("0 0 * * * *");
+    cache.get("0 30 * * * *");
+    cache.get("0 0 * * * *");
+    cache.get("0 15 * * * *");
+    assert(cache.size() == 2 && cache.get_hit_count() == 1 &&
+           cache.get_miss_count() == 3 && "❌ Cron cache counts wrong!");
+    cache.get("0 0 * * * *");
+    cache.get("0 30 * * * *");
+    assert(cache.get_hit_count() == 2 && cache.get_miss_count() == 4 &&
+           "❌ Cron cache evicted the wrong entry!");
+    bool thrown{false};
+    try
+    {
+        cache.get("0 0 0 30 2 * *");
+    }
+    catch (const cron::bad_cronexpr&)
+    {
+        thrown = true;
+    }
+    assert(thrown && cache.size() == 2 && "❌ Invalid expression cached!");
+
+    // 批量添加重复的表达式只解析一次
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 4);
+    auto& shared = CronCache::shared();
+    size_t misses = shared.get_miss_count();
+    size_t hits = shared.get_hit_count();
+    std::vector<ChronixScheduler::CronJobSpec> specs;
+    for (size_t i = 0; i != 100; i++)
+    {
+        specs.emplace_back(i % 2 ? "0 0 3 * * *" : "0 0 4 * * MON", []() {});
+    }
+    scheduler->add_cron_jobs(specs);
+    assert(shared.get_miss_count() - misses <= 2 &&
+           shared.get_hit_count() - hits >= 98 &&
+           "❌ Repeated schedules parsed again!");
+    std::cout << "✅ Cron expressions parse without allocating!" << std::endl;
+}
+
+void test_sub_second_jobs()
+{
+    using std::chrono::milliseconds;
+    auto utc = TimeZone::utc();
+    auto second = std::chrono::system_clock::from_time_t(
+        static_cast<std::time_t>(cron::detail::civil_to_seconds(
+            {2026, 3, 1, 8, 0, 0})));
+
+    // 七个字段时第一个是毫秒, 六个字段仍在整秒触发
+    auto tenth = cron::make_cron("*/100 * * * * * *");
+    auto quarter = cron::make_cron("0,250,500,750 * * * * * *");
+    auto whole = cron::make_cron("* * * * * *");
+    assert(cron::make_cron("0 * * * * * *") == whole &&
+           cron::make_cron("*/250 * * * * * *") == quarter &&
+           "❌ Millisecond field parsed wrong!");
+    assert(cron::cron_next(tenth, second + milliseconds(120), *utc) ==
+               second + milliseconds(200) &&
+           cron::cron_next(tenth, second + milliseconds(900), *utc) ==
+               second + milliseconds(1000) &&
+           cron::cron_next(whole, second + milliseconds(500), *utc) ==
+               second + milliseconds(1000) &&
+           cron::cron_next(whole, second, *utc) == second + milliseconds(1000) &&
+           "❌ Sub-second cron_next wrong!");
+    auto top = cron::make_cron("0,500 0 * * * * *");
+    assert(cron::cron_next(top, second + milliseconds(600), *utc) ==
+               second + milliseconds(60000) &&
+           "❌ Millisecond field ignored the seconds!");
+
+    std::vector<std::chrono::system_clock::time_point> fires;
+    cron::cron_next_n(quarter, second - milliseconds(1), 9,
+                      std::back_inserter(fires), *utc);
+    for (size_t i = 0; i != fires.size(); i++)
+    {
+        assert(fires[i] == second + milliseconds(250 * i) &&
+               "❌ Sub-second fires enumerated wrong!");
+    }
+    size_t in_second{0};
+    for (auto fire : cron::cron_between(tenth, second, second + milliseconds(1000),
+                                        *utc))
+    {
+        (void)fire;
+        in_second++;
+    }
+    assert(in_second == 10 && "❌ Sub-second range counted wrong!");
+
+    // 抖动不超过相邻两次触发的间隔, 高频任务不丢失运行
+    auto scheduler = std::make_shared<ChronixScheduler>(2, 4);
+    scheduler->set_time_zone("UTC");
+    scheduler->set_jitter(400, 400);
+    std::atomic<size_t> tenth_runs{0};
+    std::atomic<size_t> quarter_runs{0};
+    scheduler->add_cron_job("*/100 * * * * * *", [&]() { tenth_runs++; });
+    size_t quarter_id = scheduler->add_cron_job("*/250 * * * * * *",
+                                                [&]() { quarter_runs++; });
+    for (auto fire : scheduler->get_next_fire_times(quarter_id, 8))
+    {
+        auto ms = std::chrono::duration_cast<milliseconds>(
+                      fire.time_since_epoch())
+                      .count();
+        assert(ms % 250 == 0 && "❌ Sub-second job phase drifted!");
+    }
+
+    scheduler->start();
+    std::this_thread::sleep_for(milliseconds(1500));
+    scheduler->stop();
+    assert(tenth_runs >= 8 && tenth_runs <= 16 && quarter_runs >= 3 &&
+           quarter_runs <= 7 && "❌ Sub-second jobs ran at the wrong rate!");
+    std::cout << "✅ Sub-second jobs run every 100ms and 250ms!" << std::endl;
+}
+
+void test_non_std_exceptions()
+{
+    auto scheduler = std::make_shared<ChronixScheduler>(1, 4);
+    scheduler->set_jitter(0, 0);
+
+    // 任务和回调抛出的任意异常都不能终止执行线程
+    std::atomic<size_t> errors{0};
+    std::atomic<size_t> ends{0};
+    size_t thrower = scheduler->add_cron_job("*/100 * * * * * *",
+                                             []() { throw 42; });
+    scheduler->set_error_callback(thrower,
+                                  [&](size_t, const std::exception&) {
+                                      errors++;
+                                      throw 43;
+                                  });
+    scheduler->set_end_callback(thrower, [&](size_t) {
+        ends++;
+        throw std::runtime_error("end callback failed");
+    });
+
+    std::atomic<size_t> runs{0};
+    size_t guarded = scheduler->add_cron_job("*/100 * * * * * *",
+                                             [&]() { runs++; });
+    scheduler->set_start_callback(guarded, [](size_t) { throw 44; });
+
+    scheduler->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    scheduler->stop();
+
+    assert(errors >= 3 && ends >= 3 && runs == 0 &&
+           "❌ Job stopped after a non-std exception!");
+    assert(scheduler->get_job_result(thrower) == JobResult::Failed &&
+           scheduler->get_job_result(guarded) == JobResult::Failed &&
+           scheduler->get_job_status(thrower) != JobStatus::Running &&
+           scheduler->get_job_status(guarded) != JobStatus::Running &&
+           "❌ Job left running after a non-std exception!");
+    std::cout << "✅ Non-std exceptions fail the run only!" << std::endl;
+}
@@ -1,12 +1,19 @@
 /*
  * performance.cpp
  */
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <new>
+#include <numeric>
 #include <random>
 
 #include "chronix/chronix.h"
 #include "chronix/define.h"
+#include "chronix/queue/job_queue.h"
+#include "chronix/queue/timing_wheel.h"
 
 static const size_t MIN_THREADS = std::thread::hardware_concurrency() * 8;
 static const size_t MAX_THREADS = std::thread::hardware_concurrency() * 8;
@@ -27,8 +34,137 @@ static const std::string CSV_HEADER_ZH =
     "轮次编号,总执行次数,成功次数,失败次数,平均耗时(ms),最大耗时(ms),最小耗时("
     "ms),总耗时(s),吞吐量(tps),成功率,错误率";
 
+// 任务队列压测：./performance queue
+static const std::vector<size_t> QUEUE_JOBS = {100000, 1000000, 5000000};
+// 任务触发时间分布在一小时内
+static const std::chrono::seconds QUEUE_SPAN = std::chrono::seconds(3600);
+
+static const std::string QUEUE_CSV_FILENAME = "job_queue.csv";
+static const std::string QUEUE_CSV_HEADER =
+    "Queue,Jobs,Insert(ns/op),Expire(ns/op),Rearm(ns/op),TotalTime(s)";
+
+// 调度延迟压测：./performance latency
+static const size_t LATENCY_JOBS = 20000;
+// 任务到期时间分布在两秒内
+static const std::chrono::milliseconds LATENCY_SPAN =
+    std::chrono::milliseconds(2000);
+
+static const std::string LATENCY_CSV_FILENAME = "dispatch_latency.csv";
+static const std::string LATENCY_CSV_HEADER =
+    "Jobs,Threads,Avg(us),P50(us),P99(us),Max(us)";
+
+// 执行器压测：./performance executor
+static const size_t EXECUTOR_TASKS = 1000000;
+static const std::vector<size_t> EXECUTOR_PRODUCERS = {1, 4, 8};
+// 每个外部任务在工作线程内再派生的子任务数
+static const size_t EXECUTOR_FANOUT = 3;
+// 批量提交时每批的外部任务数
+static const size_t EXECUTOR_BATCH = 64;
+
+static const std::string EXECUTOR_CSV_FILENAME = "executor.csv";
+static const std::string EXECUTOR_CSV_HEADER =
+    "Executor,Producers,Tasks,TotalTime(s),Throughput(tps)";
+
+// 唤醒延迟压测：./performance wakeup
+static const size_t WAKEUP_SAMPLES = 20000;
+// 相邻两次提交的间隔, 覆盖自旋、让出和休眠三个阶段
+static const std::vector<std::chrono::microseconds> WAKEUP_GAPS = {
+    std::chrono::microseconds(10), std::chrono::microseconds(100),
+    std::chrono::microseconds(1000)};
+static const std::vector<std::pair<std::string, WorkerWait>> WAKEUP_WAITS = {
+    {"Park", {std::chrono::microseconds(0), std::chrono::microseconds(0)}},
+    {"Spin", {std::chrono::microseconds(50), std::chrono::microseconds(0)}},
+    {"SpinYield",
+     {std::chrono::microseconds(50), std::chrono::microseconds(500)}}};
+
+static const std::string WAKEUP_CSV_FILENAME = "wakeup.csv";
+static const std::string WAKEUP_CSV_HEADER =
+    "Wait,Gap(us),Samples,P50(us),P90(us),P99(us),P999(us),Max(us)";
+
+// cron 求值压测：./performance cron
+static const size_t CRON_EVALS = 10000;
+// cron_next_n 每批展开的触发次数
+static const size_t CRON_BATCH = 100;
+static const std::vector<std::string> CRON_EXPRS = {
+    "*/1 * * * * *", "0 */5 * * * *", "0 30 9 * * MON-FRI",
+    "0 0 12 13 * FRI", "0 0 0 29 2 *"};
+
+static const std::string CRON_CSV_FILENAME = "cron_next.csv";
+static const std::string CRON_CSV_HEADER =
+    "Expression,Evaluator,Evals,TotalTime(s),ns/Eval";
+
+// 内存分配压测：./performance alloc
+static const size_t ALLOC_TASKS = 100000;
+static const size_t ALLOC_CRON_JOBS = 1000;
+// 周期任务预热后统计的时间窗口
+static const std::chrono::milliseconds ALLOC_WINDOW =
+    std::chrono::milliseconds(3000);
+
+static const std::string ALLOC_CSV_FILENAME = "alloc.csv";
+static const std::string ALLOC_CSV_HEADER = "Path,Runs,Allocs,Allocs/Run";
+
+// 统计期间计数全局 operator new
+static std::atomic<bool> alloc_counting{false};
+static std::atomic<size_t> alloc_count{0};
+
+void* operator new(size_t size)
+{
+    if (alloc_counting.load(std::memory_order_relaxed))
+    {
+        alloc_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+// 不内联, 避免编译器把 new/free 配对误报为不匹配
+[[gnu::noinline]] void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+static int performance_job_queue();
+static int performance_dispatch_latency();
+static int performance_executor();
+static int performance_alloc();
+static int performance_wakeup();
+static int performance_cron();
+
 int main(int argc, char* argv[])
 {
+    if (argc > 1 && std::string(argv[1]) == "queue")
+    {
+        return performance_job_queue();
+    }
+    if (argc > 1 && std::string(argv[1]) == "latency")
+    {
+        return performance_dispatch_latency();
+    }
+    if (argc > 1 && std::string(argv[1]) == "executor")
+    {
+        return performance_executor();
+    }
+    if (argc > 1 && std::string(argv[1]) == "alloc")
+    {
+        return performance_alloc();
+    }
+    if (argc > 1 && std::string(argv[1]) == "wakeup")
+    {
+        return performance_wakeup();
+    }
+    if (argc > 1 && std::string(argv[1]) == "cron")
+    {
+        return performance_cron();
+    }
+
     std::string filename = CSV_FILENAME_EN;
     std::string header = CSV_HEADER_EN;
 #ifdef PERFORMANCE_ZH
@@ -152,3 +288,610 @@ int main(int argc, char* argv[])
 
     return 0;
 }
+
+// 模拟调度线程：插入 -> 按秒推进时间取出到期任务 -> 重新入队一次
+static double run_job_queue(JobQueue& queue, size_t jobs,
+                            std::chrono::steady_clock::time_point start,
+                            std::ofstream& out, const std::string& name)
+{
+    using namespace std::chrono;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> offset_dist(
+        0, duration_cast<milliseconds>(QUEUE_SPAN).count());
+
+    std::vector<steady_clock::time_point> deadlines;
+    deadlines.reserve(jobs);
+    for (size_t i = 0; i != jobs; i++)
+    {
+        deadlines.emplace_back(start + milliseconds(offset_dist(rng)));
+    }
+
+    auto begin = steady_clock::now();
+
+    auto insert_begin = steady_clock::now();
+    for (size_t i = 0; i != jobs; i++)
+    {
+        queue.push(JobNode(i, deadlines[i]));
+    }
+    auto insert_end = steady_clock::now();
+
+    std::vector<JobNode> ready;
+    size_t expired{0};
+    duration<double> expire_time{0};
+    duration<double> rearm_time{0};
+    for (auto now = start; expired < jobs; now += seconds(1))
+    {
+        ready.clear();
+
+        auto expire_begin = steady_clock::now();
+        queue.pop_expired(now, ready);
+        auto expire_end = steady_clock::now();
+        expire_time += expire_end - expire_begin;
+        expired += ready.size();
+
+        // 周期任务重新入队
+        for (auto& node : ready)
+        {
+            queue.push(JobNode(node.id, node.next + QUEUE_SPAN));
+        }
+        rearm_time += steady_clock::now() - expire_end;
+    }
+
+    auto end = steady_clock::now();
+
+    double insert_ns =
+        duration<double, std::nano>(insert_end - insert_begin).count() / jobs;
+    double expire_ns = duration<double, std::nano>(expire_time).count() / jobs;
+    double rearm_ns = duration<double, std::nano>(rearm_time).count() / jobs;
+    double total = duration<double>(end - begin).count();
+
+    out << name << "," << jobs << "," << insert_ns << "," << expire_ns << ","
+        << rearm_ns << "," << total << "\r\n";
+    out.flush();
+
+    std::cout << "[" << name << "] " << jobs << " jobs, insert " << insert_ns
+              << " ns/op, expire " << expire_ns << " ns/op, rearm " << rearm_ns
+              << " ns/op ✅" << std::endl;
+    return total;
+}
+
+static int performance_job_queue()
+{
+    std::ofstream out(QUEUE_CSV_FILENAME);
+    out << QUEUE_CSV_HEADER << "\r\n";
+
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (auto jobs : QUEUE_JOBS)
+        {
+            {
+                HeapJobQueue queue;
+                run_job_queue(queue, jobs, start, out, "Heap");
+            }
+            {
+                TimingWheelJobQueue queue(start);
+                run_job_queue(queue, jobs, start, out, "TimingWheel");
+            }
+        }
+
+        std::cout << "✅ 任务队列压测完成，结果写入成功" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+// 从到期时间到任务开始执行的延迟
+static int performance_dispatch_latency()
+{
+    using namespace std::chrono;
+
+    std::ofstream out(LATENCY_CSV_FILENAME);
+    out << LATENCY_CSV_HEADER << "\r\n";
+
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+    auto scheduler = std::make_shared<ChronixScheduler>(threads, threads);
+    scheduler->set_jitter(0, 0);
+
+    std::vector<int64_t> latencies(LATENCY_JOBS);
+    std::atomic<size_t> done_count{0};
+    std::mutex mtx;
+    std::condition_variable cv;
+
+    try
+    {
+        scheduler->start();
+
+        auto start = system_clock::now() + milliseconds(500);
+        std::vector<ChronixScheduler::OnceJobSpec> specs;
+        specs.reserve(LATENCY_JOBS);
+        for (size_t i = 0; i != LATENCY_JOBS; i++)
+        {
+            auto run_at = start + LATENCY_SPAN * i / LATENCY_JOBS;
+            specs.emplace_back(run_at, [&, i, run_at]() {
+                latencies[i] =
+                    duration_cast<microseconds>(system_clock::now() - run_at)
+                        .count();
+                if (++done_count == LATENCY_JOBS)
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    cv.notify_one();
+                }
+            });
+        }
+        scheduler->add_once_jobs(std::move(specs));
+
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [&]() { return done_count == LATENCY_JOBS; });
+        }
+        scheduler->stop();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    double avg = std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+                 LATENCY_JOBS;
+    int64_t p50 = latencies[LATENCY_JOBS / 2];
+    int64_t p99 = latencies[LATENCY_JOBS * 99 / 100];
+    int64_t max = latencies.back();
+
+    out << LATENCY_JOBS << "," << threads << "," << avg << "," << p50 << ","
+        << p99 << "," << max << "\r\n";
+
+    std::cout << "[Latency] " << LATENCY_JOBS << " jobs, avg " << avg
+              << " us, p50 " << p50 << " us, p99 " << p99 << " us, max "
+              << max << " us ✅" << std::endl;
+    std::cout << "✅ 调度延迟压测完成，结果写入成功" << std::endl;
+
+    return 0;
+}
+
+// 多个生产者提交小任务, 任务执行时再派生子任务
+static double run_executor(Executor& executor, size_t producers,
+                           std::ofstream& out, const std::string& name,
+                           size_t batch = 0)
+{
+    using namespace std::chrono;
+
+    size_t roots = EXECUTOR_TASKS / (EXECUTOR_FANOUT + 1);
+    size_t total = roots * (EXECUTOR_FANOUT + 1);
+
+    std::atomic<size_t> done_count{0};
+    std::mutex mtx;
+    std::condition_variable cv;
+
+    auto finish = [&]() {
+        if (++done_count == total)
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            cv.notify_one();
+        }
+    };
+
+    auto root = [&]() {
+        if (batch == 0)
+        {
+            for (size_t c = 0; c != EXECUTOR_FANOUT; c++)
+            {
+                executor.post(finish);
+            }
+        }
+        else
+        {
+            std::vector<unique_function<void()>> children;
+            for (size_t c = 0; c != EXECUTOR_FANOUT; c++)
+            {
+                children.emplace_back(finish);
+            }
+            executor.post_bulk(children, JobPriority::Normal);
+        }
+        finish();
+    };
+
+    auto begin = steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p != producers; p++)
+    {
+        threads.emplace_back([&, p]() {
+            std::vector<unique_function<void()>> pending;
+            for (size_t i = p; i < roots; i += producers)
+            {
+                if (batch == 0)
+                {
+                    executor.post(root);
+                    continue;
+                }
+                pending.emplace_back(root);
+                if (pending.size() == batch)
+                {
+                    executor.post_bulk(pending, JobPriority::Normal);
+                }
+            }
+            if (!pending.empty())
+            {
+                executor.post_bulk(pending, JobPriority::Normal);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&]() { return done_count == total; });
+    }
+
+    double seconds = duration<double>(steady_clock::now() - begin).count();
+    double tps = total / seconds;
+
+    out << name << "," << producers << "," << total << "," << seconds << ","
+        << tps << "\r\n";
+    out.flush();
+
+    std::cout << "[" << name << "] " << producers << " producers, " << total
+              << " tasks, " << seconds << " s, " << tps << " tps ✅"
+              << std::endl;
+    return seconds;
+}
+
+static int performance_executor()
+{
+    std::ofstream out(EXECUTOR_CSV_FILENAME);
+    out << EXECUTOR_CSV_HEADER << "\r\n";
+
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+
+    try
+    {
+        for (auto producers : EXECUTOR_PRODUCERS)
+        {
+            {
+                ThreadPool executor(threads, threads);
+                run_executor(executor, producers, out, "ThreadPool");
+            }
+            {
+                ThreadPool executor(threads, threads);
+                run_executor(executor, producers, out, "ThreadPoolBulk",
+                             EXECUTOR_BATCH);
+            }
+            {
+                WorkStealingPool executor(threads);
+                run_executor(executor, producers, out, "WorkStealing");
+            }
+        }
+
+        std::cout << "✅ 执行器压测完成，结果写入成功" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+static void write_alloc(std::ofstream& out, const std::string& name,
+                        size_t runs, size_t allocs)
+{
+    double per_run = static_cast<double>(allocs) / runs;
+    out << name << "," << runs << "," << allocs << "," << per_run << "\r\n";
+    out.flush();
+
+    std::cout << "[" << name << "] " << runs << " runs, " << allocs
+              << " allocs, " << per_run << " allocs/run ✅" << std::endl;
+}
+
+// 向线程池提交任务并等待全部完成, 返回期间的分配次数
+template <typename Pool, typename Submit>
+static size_t count_pool_allocs(Pool& pool, Submit submit)
+{
+    std::atomic<size_t> done_count{0};
+    std::mutex mtx;
+    std::condition_variable cv;
+
+    auto finish = [&]() {
+        if (++done_count == ALLOC_TASKS)
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            cv.notify_one();
+        }
+    };
+
+    alloc_count = 0;
+    alloc_counting = true;
+    for (size_t i = 0; i != ALLOC_TASKS; i++)
+    {
+        submit(pool, finish);
+    }
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&]() { return done_count == ALLOC_TASKS; });
+    }
+    alloc_counting = false;
+    return alloc_count;
+}
+
+static int performance_alloc()
+{
+    using namespace std::chrono;
+
+    std::ofstream out(ALLOC_CSV_FILENAME);
+    out << ALLOC_CSV_HEADER << "\r\n";
+
+    try
+    {
+        ThreadPool pool(1, 1);
+        std::vector<std::future<void>> futures;
+        futures.reserve(ALLOC_TASKS);
+
+        // 旧的提交方式: shared_ptr<packaged_task> 包在 std::function 中
+        size_t allocs = count_pool_allocs(pool, [&](ThreadPool& p, auto& f) {
+            auto task = std::make_shared<std::packaged_task<void()>>(f);
+            futures.emplace_back(task->get_future());
+            p.post(std::function<void()>([task]() { (*task)(); }));
+        });
+        write_alloc(out, "SharedPackagedTask", ALLOC_TASKS, allocs);
+        futures.clear();
+
+        allocs = count_pool_allocs(pool, [&](ThreadPool& p, auto& f) {
+            futures.emplace_back(p.submit(f));
+        });
+        write_alloc(out, "Submit", ALLOC_TASKS, allocs);
+        futures.clear();
+
+        allocs = count_pool_allocs(
+            pool, [](ThreadPool& p, auto& f) { p.submit_detached(f); });
+        write_alloc(out, "SubmitDetached", ALLOC_TASKS, allocs);
+
+        allocs = count_pool_allocs(
+            pool, [](ThreadPool& p, auto& f) { p.post([&f]() { f(); }); });
+        write_alloc(out, "Post", ALLOC_TASKS, allocs);
+
+        // 工作窃取池复用任务节点, 先跑一轮让空闲链表达到峰值积压
+        WorkStealingPool stealing(1);
+        auto stealing_post = [](WorkStealingPool& p, auto& f) {
+            p.post([&f]() { f(); });
+        };
+        count_pool_allocs(stealing, stealing_post);
+        allocs = count_pool_allocs(stealing, stealing_post);
+        write_alloc(out, "WorkStealingPost", ALLOC_TASKS, allocs);
+
+        // 周期任务每次执行的分配次数
+        auto scheduler = std::make_shared<ChronixScheduler>(4, 4);
+        std::atomic<size_t> runs{0};
+        scheduler->start();
+        for (size_t i = 0; i != ALLOC_CRON_JOBS; i++)
+        {
+            scheduler->add_cron_job("*/1 * * * * *", [&]() { runs++; });
+        }
+        std::this_thread::sleep_for(milliseconds(1500));
+
+        alloc_count = 0;
+        size_t runs_begin = runs;
+        alloc_counting = true;
+        std::this_thread::sleep_for(ALLOC_WINDOW);
+        alloc_counting = false;
+        size_t window_runs = runs - runs_begin;
+        allocs = alloc_count;
+        scheduler->stop();
+
+        write_alloc(out, "CronJob", window_runs, allocs);
+        std::cout << "✅ 内存分配压测完成，结果写入成功" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+// 单个生产者按固定间隔提交, 记录提交到开始执行的时间
+static void run_wakeup(const std::string& name, const WorkerWait& wait,
+                       std::chrono::microseconds gap, std::ofstream& out)
+{
+    using namespace std::chrono;
+
+    ThreadPool pool(2, 2);
+    pool.set_worker_wait(wait);
+
+    std::vector<int64_t> latencies(WAKEUP_SAMPLES);
+    std::atomic<size_t> done_count{0};
+    for (size_t i = 0; i != WAKEUP_SAMPLES; i++)
+    {
+        auto posted = steady_clock::now();
+        pool.post([&, i, posted]() {
+            latencies[i] =
+                duration_cast<nanoseconds>(steady_clock::now() - posted)
+                    .count();
+            done_count++;
+        });
+
+        // 忙等而非 sleep, 间隔不受定时器精度影响
+        while (steady_clock::now() - posted < gap)
+        {
+        }
+    }
+    while (done_count != WAKEUP_SAMPLES)
+    {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto at = [&](size_t permille) {
+        return latencies[WAKEUP_SAMPLES * permille / 1000] / 1000.0;
+    };
+    double max = latencies.back() / 1000.0;
+
+    out << name << "," << gap.count() << "," << WAKEUP_SAMPLES << ","
+        << at(500) << "," << at(900) << "," << at(990) << "," << at(999)
+        << "," << max << "\r\n";
+    out.flush();
+
+    std::cout << "[" << name << "] gap " << gap.count() << " us, p50 "
+              << at(500) << " us, p99 " << at(990) << " us, p999 "
+              << at(999) << " us, max " << max << " us ✅" << std::endl;
+}
+
+static int performance_wakeup()
+{
+    std::ofstream out(WAKEUP_CSV_FILENAME);
+    out << WAKEUP_CSV_HEADER << "\r\n";
+
+    try
+    {
+        for (auto gap : WAKEUP_GAPS)
+        {
+            for (const auto& [name, wait] : WAKEUP_WAITS)
+            {
+                run_wakeup(name, wait, gap, out);
+            }
+        }
+
+        std::cout << "✅ 唤醒延迟压测完成，结果写入成功" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+// 从同一起点连续求下一次触发时间, 每次以上一次结果为起点
+template <typename Next>
+static void run_cron(const std::string& expr, const std::string& name,
+                     Next next, std::ofstream& out)
+{
+    std::time_t from = std::time(nullptr);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != CRON_EVALS; i++)
+    {
+        std::time_t calculated = next(from);
+        // 不可能的表达式从原点重新开始
+        from = calculated == cron::INVALID_TIME ? from + 1 : calculated;
+    }
+    double total = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+    out << "\"" << expr << "\"," << name << "," << CRON_EVALS << ","
+        << total << "," << total * 1e9 / CRON_EVALS << "\r\n";
+    out.flush();
+
+    std::cout << "[" << name << "] " << expr << ": "
+              << total * 1e9 / CRON_EVALS << " ns/eval ✅" << std::endl;
+}
+
+// 重复解析同一表达式
+template <typename Parse>
+static void run_parse(const std::string& expr, const std::string& name,
+                      Parse parse, std::ofstream& out)
+{
+    size_t matched{0};
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != CRON_EVALS; i++)
+    {
+        matched += cron::to_cronstr(parse(expr)).size() == expr.size();
+    }
+    double total = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    if (matched != CRON_EVALS)
+    {
+        throw std::runtime_error("Parsed expression mismatch: " + expr);
+    }
+
+    out << "\"" << expr << "\"," << name << "," << CRON_EVALS << ","
+        << total << "," << total * 1e9 / CRON_EVALS << "\r\n";
+    out.flush();
+
+    std::cout << "[" << name << "] " << expr << ": "
+              << total * 1e9 / CRON_EVALS << " ns/eval ✅" << std::endl;
+}
+
+static int performance_cron()
+{
+    std::ofstream out(CRON_CSV_FILENAME);
+    out << CRON_CSV_HEADER << "\r\n";
+
+    try
+    {
+        auto zone = TimeZone::local();
+        for (const auto& expr : CRON_EXPRS)
+        {
+            auto cex = cron::make_cron(expr);
+            run_cron(expr, "ClosedForm",
+                     [&](std::time_t from) {
+                         return cron::cron_next(cex, from);
+                     },
+                     out);
+            // 进程内时区表换算, 不经过 localtime 和 mktime
+            run_cron(expr, "TimeZone",
+                     [&](std::time_t from) {
+                         return cron::cron_next(cex, from, *zone);
+                     },
+                     out);
+            // 批量展开, 日历状态在一批内连续推进
+            std::vector<std::chrono::system_clock::time_point> batch;
+            size_t taken{0};
+            run_cron(expr, "Enumerate",
+                     [&](std::time_t from) {
+                         if (taken == batch.size())
+                         {
+                             batch.clear();
+                             taken = 0;
+                             auto start =
+                                 std::chrono::system_clock::from_time_t(from);
+                             cron::cron_next_n(cex, start, CRON_BATCH,
+                                               std::back_inserter(batch),
+                                               *zone);
+                             if (batch.empty())
+                             {
+                                 return cron::INVALID_TIME;
+                             }
+                         }
+                         return std::chrono::system_clock::to_time_t(
+                             batch[taken++]);
+                     },
+                     out);
+
+            run_parse(expr, "Parse",
+                      [](const std::string& text) {
+                          return cron::make_cron(text);
+                      },
+                      out);
+            run_parse(expr, "Cached",
+                      [](const std::string& text) {
+                          return CronCache::shared().get(text);
+                      },
+                      out);
+        }
+
+        std::cout << "✅ cron 求值压测完成，结果写入成功" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -1,30 +1,58 @@
 #pragma once
 
 #include <atomic>
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <iterator>
 #include <iostream>
 #include <mutex>
 #include <optional>
 #include <random>
 #include <string>
 #include <thread>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "chronix/coroutine/async_task.h"
+#include "chronix/cron_cache.h"
 #include "chronix/croncpp.h"
 #include "chronix/define.h"
 #include "chronix/persistence/persistence.h"
+#include "chronix/queue/job_queue.h"
+#include "chronix/queue/timing_wheel.h"
+#include "chronix/slot_map.h"
+#include "chronix/time_zone.h"
+#include "chronix/thread_pool/affinity.h"
+#include "chronix/thread_pool/executor.h"
+#include "chronix/thread_pool/numa_pool.h"
 #include "chronix/thread_pool/thread_pool.h"
+#include "chronix/thread_pool/work_stealing_pool.h"
 
 class ChronixScheduler
 {
 public:
-    ChronixScheduler(size_t min_threads = 1,
-                     size_t max_threads = 8 *
-                                          std::thread::hardware_concurrency())
-        : running(false), next_job_id(1), metrics_enabled(false)
+    // name of the executor given to the constructor
+    static inline const std::string DEFAULT_POOL{"default"};
+
+    ChronixScheduler(
+        size_t min_threads = 1,
+        size_t max_threads = 8 * std::thread::hardware_concurrency(),
+        JobQueueType queue_type = JobQueueType::Heap,
+        size_t shard_count = 1)
+        : running(false), next_shard_index(0), metrics_enabled(false)
     {
+        if (shard_count == 0)
+        {
+            throw std::runtime_error("shard_count == 0");
+        }
+
+        clock_anchor = ClockAnchor{std::chrono::system_clock::now(),
+                                   std::chrono::steady_clock::now(), 0};
+
         try
         {
             thread_pool =
@@ -35,22 +63,53 @@ public:
             throw std::runtime_error(
                 std::string("Failed to create thread pool: ") + e.what());
         }
+
+        for (size_t i = 0; i != shard_count; i++)
+        {
+            auto shard = std::make_unique<Shard>(
+                static_cast<uint32_t>(shard_count), static_cast<uint32_t>(i));
+            switch (queue_type)
+            {
+            case JobQueueType::Heap:
+                shard->job_queue = std::make_unique<HeapJobQueue>();
+                break;
+            case JobQueueType::TimingWheel:
+                shard->job_queue = std::make_unique<TimingWheelJobQueue>();
+                break;
+            }
+            shard->anchor = clock_anchor;
+            shards.emplace_back(std::move(shard));
+        }
     }
 
     ~ChronixScheduler()
     {
         stop();
+
+#ifdef CHRONIX_COROUTINES
+        // 挂起的协程任务带着错误恢复, 在执行器析构排空时结束
+        async_closing = true;
+        async_timer.stop();
+        pools.clear();
+        thread_pool.reset();
+#endif
     }
 
-    // cron job
-    size_t add_cron_job(const std::string& cron_expr, Task task)
+    // cron job, evaluated in the named zone or the scheduler's if empty
+    size_t add_cron_job(const std::string& cron_expr, Task task,
+                        JobPriority priority = JobPriority::Normal,
+                        const std::string& pool = DEFAULT_POOL,
+                        const std::string& time_zone = "")
     {
-        size_t job_id = next_job_id++;
+        size_t job_id;
+        size_t pool_id = pool_of(pool);
+        auto zone = zone_of(time_zone);
+        auto& shard = next_shard();
         cron::cronexpr expr;
 
         try
         {
-            expr = cron::make_cron(cron_expr);
+            expr = CronCache::shared().get(cron_expr);
         }
         catch (const std::exception& e)
         {
@@ -58,20 +117,11 @@ public:
         }
 
         // 防止周期任务立刻执行
-        auto calculated_next = std::chrono::system_clock::now();
-        size_t attempt{0};
-        do
-        {
-            calculated_next = cron::cron_next(expr, calculated_next);
-            attempt++;
-        } while (calculated_next <= std::chrono::system_clock::now() &&
-                 attempt < attempt_max);
+        auto calculated_next =
+            next_cron_time(expr, *zone, std::chrono::system_clock::now());
 
-        // 引入随机抖动，避免集中处理任务
-        static thread_local std::mt19937 rng(std::random_device{}());
-        std::uniform_int_distribution<size_t> dist(jitter_min_ms,
-                                                   jitter_max_ms);
-        auto jitter = std::chrono::milliseconds(dist(rng));
+        auto jitter =
+            bound_jitter(expr, *zone, calculated_next, random_jitter());
 
         auto safe_next_time = calculated_next + jitter;
 
@@ -85,151 +135,316 @@ public:
         // }
 
         {
-            std::lock_guard<std::mutex> lock(mutex);
-            job_queue.emplace(job_id, safe_next_time);
-            job_map.emplace(job_id, Job{
-                                        job_id,
-                                        expr,
-                                        cron_expr,
-                                        std::move(task),
-                                        safe_next_time,
-                                        nullptr,
-                                        nullptr,
-                                        nullptr,
-                                        nullptr,
-                                        JobStatus::Pending,
-                                        JobResult::Unknown,
-                                        JobType::Cron,
-                                    });
-        }
-
-        cv.notify_one();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            job_id = insert_job(
+                shard, make_job(JobType::Cron, expr, cron_expr,
+                                std::move(task), safe_next_time, priority,
+                                pool_id, zone));
+            enqueue_job(shard, *shard.job_map.find(job_id));
+        }
+
+        shard.cv.notify_one();
         return job_id;
     }
 
     // add once job
     size_t add_once_job(const std::chrono::system_clock::time_point& run_at,
-                        Task task)
+                        Task task, JobPriority priority = JobPriority::Normal,
+                        const std::string& pool = DEFAULT_POOL)
     {
-        size_t job_id = next_job_id++;
+        size_t job_id;
+        size_t pool_id = pool_of(pool);
+        auto& shard = next_shard();
 
-        // 引入随机抖动，避免集中处理任务
-        static thread_local std::mt19937 rng(std::random_device{}());
-        std::uniform_int_distribution<size_t> dist(jitter_min_ms,
-                                                   jitter_max_ms);
-        auto jitter = std::chrono::milliseconds(dist(rng));
-
-        auto safe_next_time = run_at + jitter;
-
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            job_queue.emplace(job_id, run_at);
-            job_map.emplace(job_id, Job{
-                                        job_id,
-                                        {},
-                                        "",
-                                        std::move(task),
-                                        safe_next_time,
-                                        nullptr,
-                                        nullptr,
-                                        nullptr,
-                                        nullptr,
-                                        JobStatus::Pending,
-                                        JobResult::Unknown,
-                                        JobType::Once,
-                                    });
-        }
-
-        cv.notify_one();
+        auto safe_next_time = run_at + random_jitter();
+
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            job_id = insert_job(
+                shard, make_job(JobType::Once, {}, "", std::move(task),
+                                safe_next_time, priority, pool_id));
+            shard.job_queue->push(
+                JobNode(job_id, to_deadline(shard, safe_next_time)));
+        }
+
+        shard.cv.notify_one();
         return job_id;
     }
 
     // add immediate job
-    size_t add_immediate_job(Task task)
+    size_t add_immediate_job(Task task,
+                             JobPriority priority = JobPriority::Normal,
+                             const std::string& pool = DEFAULT_POOL)
     {
-        size_t job_id = next_job_id++;
+        size_t job_id;
+        size_t pool_id = pool_of(pool);
+        auto& shard = next_shard();
 
-        // 引入随机抖动，避免集中处理任务
-        static thread_local std::mt19937 rng(std::random_device{}());
-        std::uniform_int_distribution<size_t> dist(jitter_min_ms,
-                                                   jitter_max_ms);
-        auto jitter = std::chrono::milliseconds(dist(rng));
-
-        auto earlier = std::chrono::system_clock::now() + jitter;
-
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            job_queue.emplace(job_id, earlier);
-            job_map.emplace(job_id, Job{
-                                        job_id,
-                                        {},
-                                        "",
-                                        std::move(task),
-                                        earlier,
-                                        nullptr,
-                                        nullptr,
-                                        nullptr,
-                                        nullptr,
-                                        JobStatus::Pending,
-                                        JobResult::Unknown,
-                                        JobType::Immediate,
-                                    });
-        }
-
-        cv.notify_one();
+        auto earlier = std::chrono::system_clock::now() + random_jitter();
+
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            job_id = insert_job(
+                shard, make_job(JobType::Immediate, {}, "", std::move(task),
+                                earlier, priority, pool_id));
+            shard.job_queue->push(
+                JobNode(job_id, to_deadline(shard, earlier)));
+        }
+
+        shard.cv.notify_one();
         return job_id;
     }
 
+    // one job of add_cron_jobs
+    struct CronJobSpec
+    {
+        CronJobSpec(std::string cron_expr, Task task,
+                    JobPriority priority = JobPriority::Normal,
+                    std::string pool = DEFAULT_POOL,
+                    std::string time_zone = "")
+            : cron_expr(std::move(cron_expr)), task(std::move(task)),
+              priority(priority), pool(std::move(pool)),
+              time_zone(std::move(time_zone))
+        {}
+
+        std::string cron_expr;
+        Task task;
+        JobPriority priority;
+        std::string pool;
+        std::string time_zone;
+    };
+
+    // one job of add_once_jobs
+    struct OnceJobSpec
+    {
+        OnceJobSpec(std::chrono::system_clock::time_point run_at, Task task,
+                    JobPriority priority = JobPriority::Normal,
+                    std::string pool = DEFAULT_POOL)
+            : run_at(run_at), task(std::move(task)), priority(priority),
+              pool(std::move(pool))
+        {}
+
+        std::chrono::system_clock::time_point run_at;
+        Task task;
+        JobPriority priority;
+        std::string pool;
+    };
+
+    // one job of add_immediate_jobs
+    struct ImmediateJobSpec
+    {
+        ImmediateJobSpec(Task task, JobPriority priority = JobPriority::Normal,
+                         std::string pool = DEFAULT_POOL)
+            : task(std::move(task)), priority(priority), pool(std::move(pool))
+        {}
+
+        Task task;
+        JobPriority priority;
+        std::string pool;
+    };
+
+    // add cron jobs from a range of CronJobSpec, tasks are moved out of an
+    // rvalue range
+    template <typename Range>
+    std::vector<size_t> add_cron_jobs(Range&& specs)
+    {
+        std::vector<Job> jobs;
+
+        // 锁外解析全部表达式和池名, 任一失败则整体不添加
+        auto now = std::chrono::system_clock::now();
+        for (auto&& spec : specs)
+        {
+            size_t pool_id = pool_of(spec.pool);
+            auto zone = zone_of(spec.time_zone);
+            cron::cronexpr expr;
+
+            try
+            {
+                expr = CronCache::shared().get(spec.cron_expr);
+            }
+            catch (const std::exception& e)
+            {
+                throw std::runtime_error("Invalid cron expression");
+            }
+
+            auto calculated_next = next_cron_time(expr, *zone, now);
+            auto safe_next_time =
+                calculated_next +
+                bound_jitter(expr, *zone, calculated_next, random_jitter());
+            jobs.emplace_back(make_job(
+                JobType::Cron, expr, spec.cron_expr,
+                forward_element<Range>(spec.task), safe_next_time,
+                spec.priority, pool_id, std::move(zone)));
+        }
+
+        return add_jobs(jobs);
+    }
+
+    // add once jobs from a range of OnceJobSpec
+    template <typename Range>
+    std::vector<size_t> add_once_jobs(Range&& specs)
+    {
+        std::vector<Job> jobs;
+
+        for (auto&& spec : specs)
+        {
+            size_t pool_id = pool_of(spec.pool);
+            auto safe_next_time = spec.run_at + random_jitter();
+            jobs.emplace_back(make_job(JobType::Once, {}, "",
+                                       forward_element<Range>(spec.task),
+                                       safe_next_time, spec.priority,
+                                       pool_id));
+        }
+
+        return add_jobs(jobs);
+    }
+
+    // add immediate jobs from a range of ImmediateJobSpec
+    template <typename Range>
+    std::vector<size_t> add_immediate_jobs(Range&& specs)
+    {
+        std::vector<Job> jobs;
+
+        auto now = std::chrono::system_clock::now();
+        for (auto&& spec : specs)
+        {
+            size_t pool_id = pool_of(spec.pool);
+            auto earlier = now + random_jitter();
+            jobs.emplace_back(make_job(JobType::Immediate, {}, "",
+                                       forward_element<Range>(spec.task),
+                                       earlier, spec.priority, pool_id));
+        }
+
+        return add_jobs(jobs);
+    }
+
+#ifdef CHRONIX_COROUTINES
+    // cron job whose body is a coroutine, it holds no worker while it
+    // awaits a timer or an I/O callback
+    size_t add_cron_job_async(const std::string& cron_expr, AsyncJob job,
+                              JobPriority priority = JobPriority::Normal,
+                              const std::string& pool = DEFAULT_POOL,
+                              const std::string& time_zone = "")
+    {
+        size_t pool_id = pool_of(pool);
+        auto zone = zone_of(time_zone);
+        cron::cronexpr expr;
+
+        try
+        {
+            expr = CronCache::shared().get(cron_expr);
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error("Invalid cron expression");
+        }
+
+        auto calculated_next =
+            next_cron_time(expr, *zone, std::chrono::system_clock::now());
+        auto safe_next_time =
+            calculated_next +
+            bound_jitter(expr, *zone, calculated_next, random_jitter());
+
+        std::vector<Job> jobs;
+        jobs.emplace_back(make_job(JobType::Cron, expr, cron_expr, nullptr,
+                                   safe_next_time, priority, pool_id, zone));
+        jobs.back().async_start = make_async_start(std::move(job));
+        return add_jobs(jobs).front();
+    }
+
+    // once job whose body is a coroutine
+    size_t add_once_job_async(
+        const std::chrono::system_clock::time_point& run_at, AsyncJob job,
+        JobPriority priority = JobPriority::Normal,
+        const std::string& pool = DEFAULT_POOL)
+    {
+        size_t pool_id = pool_of(pool);
+
+        std::vector<Job> jobs;
+        jobs.emplace_back(make_job(JobType::Once, {}, "", nullptr,
+                                   run_at + random_jitter(), priority,
+                                   pool_id));
+        jobs.back().async_start = make_async_start(std::move(job));
+        return add_jobs(jobs).front();
+    }
+
+    // immediate job whose body is a coroutine
+    size_t add_immediate_job_async(AsyncJob job,
+                                   JobPriority priority = JobPriority::Normal,
+                                   const std::string& pool = DEFAULT_POOL)
+    {
+        size_t pool_id = pool_of(pool);
+
+        std::vector<Job> jobs;
+        jobs.emplace_back(make_job(
+            JobType::Immediate, {}, "", nullptr,
+            std::chrono::system_clock::now() + random_jitter(), priority,
+            pool_id));
+        jobs.back().async_start = make_async_start(std::move(job));
+        return add_jobs(jobs).front();
+    }
+
+    // number of coroutine jobs suspended on the timer
+    size_t get_suspended_job_count()
+    {
+        return async_timer.size();
+    }
+#endif
+
     void set_start_callback(size_t job_id, StartCallback callback)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = job_map.find(job_id);
-        if (it == job_map.end())
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
         }
-        it->second.start_callback = std::move(callback);
+        job->start_callback = std::move(callback);
     }
 
     void set_success_callback(size_t job_id, SuccessCallback callback)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = job_map.find(job_id);
-        if (it == job_map.end())
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
         }
-        job_map[job_id].success_callback = std::move(callback);
+        job->success_callback = std::move(callback);
     }
 
     void set_error_callback(size_t job_id, ErrorCallback callback)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = job_map.find(job_id);
-        if (it == job_map.end())
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
         }
-        job_map[job_id].error_callback = std::move(callback);
+        job->error_callback = std::move(callback);
     }
 
     void set_end_callback(size_t job_id, EndCallback callback)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = job_map.find(job_id);
-        if (it == job_map.end())
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
         }
-        job_map[job_id].end_callback = std::move(callback);
+        job->end_callback = std::move(callback);
     }
 
     void set_metrics_enabled(bool enabled)
@@ -237,73 +452,165 @@ public:
         metrics_enabled = enabled;
     }
 
+    void set_misfire_policy(size_t job_id, MisfirePolicy policy)
+    {
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
+        {
+            throw std::runtime_error("Job ID " + std::to_string(job_id) +
+                                     " not found");
+        }
+        job->misfire_policy = policy;
+    }
+
+    // set the executor lane of a job, applies from its next run
+    void set_priority(size_t job_id, JobPriority priority)
+    {
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
+        {
+            throw std::runtime_error("Job ID " + std::to_string(job_id) +
+                                     " not found");
+        }
+        job->priority = priority;
+    }
+
+    // move a job to a named executor pool, applies from its next run
+    void set_job_pool(size_t job_id, const std::string& pool)
+    {
+        size_t pool_id = pool_of(pool);
+
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
+        {
+            throw std::runtime_error("Job ID " + std::to_string(job_id) +
+                                     " not found");
+        }
+        job->pool = pool_id;
+    }
+
+    // fires later than threshold count as missed, set before start
+    void set_misfire_threshold(std::chrono::milliseconds threshold)
+    {
+        misfire_threshold = threshold;
+    }
+
+    // zone of cron jobs added without one, such as "Asia/Shanghai", the
+    // process zone by default, jobs already added keep their zone
+    void set_time_zone(const std::string& name)
+    {
+        auto zone = TimeZone::locate(name);
+        std::lock_guard<std::mutex> lock(time_zone_mutex);
+        time_zone = std::move(zone);
+    }
+
+    std::string get_time_zone()
+    {
+        std::lock_guard<std::mutex> lock(time_zone_mutex);
+        return time_zone->name();
+    }
+
+    // share one queue node per cron expression, set before adding jobs
+    void set_fire_groups_enabled(bool enabled)
+    {
+        fire_groups_enabled = enabled;
+    }
+
+    // random jitter added to every next run time, set before adding jobs
+    void set_jitter(size_t min_ms, size_t max_ms)
+    {
+        if (min_ms > max_ms)
+        {
+            throw std::runtime_error("jitter min_ms > max_ms");
+        }
+        jitter_min_ms = min_ms;
+        jitter_max_ms = max_ms;
+    }
+
     // remove job
     void remove_job(size_t job_id)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = job_map.find(job_id);
-        if (it == job_map.end())
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
         }
-        if (it->second.status == JobStatus::Running)
+        if (job->status == JobStatus::Running)
         {
             throw std::runtime_error(
                 "Cannot remove a job that is currently running (job_id = " +
                 std::to_string(job_id) + ")");
         }
 
-        // 延时删除任务
-        it->second.deleted = true;
+        shard.job_queue->remove(job_id);
+        leave_group(shard, job_id);
+        shard.job_initializers_.erase(job_id);
+        erase_job(shard, job_id);
     }
 
     // pause job
     void pause_job(size_t job_id)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = job_map.find(job_id);
-        if (it == job_map.end())
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
         }
-        if (it->second.status == JobStatus::Running)
+        if (job->status == JobStatus::Running)
         {
             throw std::runtime_error(
                 "Cannot pause a job that is currently running (job_id = " +
                 std::to_string(job_id) + ")");
         }
 
-        it->second.status = JobStatus::Paused;
+        shard.job_queue->remove(job_id);
+        set_status(shard, *job, JobStatus::Paused);
     }
 
     // resume job
     void resume_job(size_t job_id)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = job_map.find(job_id);
-        if (it == job_map.end())
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
         }
-        if (it->second.deleted)
-        {
-            throw std::runtime_error(
-                "Cannot resume a job that has been deleted (job_id = " +
-                std::to_string(job_id) + ")");
-        }
-        if (it->second.status != JobStatus::Paused)
+        if (job->status != JobStatus::Paused)
         {
             throw std::runtime_error("Can only resume a paused job (job_id = " +
                                      std::to_string(job_id) + ")");
         }
 
-        it->second.status = JobStatus::Pending;
+        set_status(shard, *job, JobStatus::Pending);
+        if (job->type == JobType::Cron)
+        {
+            job->next = next_cron_time(job->expr, *job->time_zone,
+                                       std::chrono::system_clock::now());
+        }
+        enqueue_job(shard, *job);
+
+        shard.cv.notify_one();
     }
 
     // scheduler start
@@ -316,44 +623,25 @@ public:
 
         running = true;
 
-        worker = std::thread([this]() {
-            while (running)
-            {
-                std::vector<JobNode> ready_nodes;
-
-                {
-                    std::unique_lock<std::mutex> lock(mutex);
-
-                    if (job_queue.empty())
-                    {
-                        cv.wait(lock);
-                        continue;
-                    }
-
-                    auto now = std::chrono::system_clock::now();
-                    while (!job_queue.empty() && now >= job_queue.top().next)
-                    {
-                        ready_nodes.emplace_back(job_queue.top());
-                        job_queue.pop();
-                    }
-
-                    if (ready_nodes.empty())
-                    {
-                        auto next_wake = job_queue.top().next;
-                        if (next_wake > now)
-                        {
-                            cv.wait_until(lock, next_wake);
-                        }
-                        continue;
-                    }
-                }
+        for (auto& shard : shards)
+        {
+            shard->worker = std::thread(&ChronixScheduler::dispatch, this,
+                                        std::ref(*shard));
+        }
+        pin_dispatchers();
+    }
 
-                for (auto& node : ready_nodes)
-                {
-                    thread_pool->submit([this, node]() { process_job(node); });
-                }
-            }
-        });
+    // pin dispatcher thread i to cpus[i % cpus.size()], empty lets them float
+    void set_dispatcher_affinity(std::vector<size_t> cpus)
+    {
+        {
+            std::lock_guard<std::mutex> lock(affinity_mutex);
+            dispatcher_cpus = std::move(cpus);
+        }
+        if (running)
+        {
+            pin_dispatchers();
+        }
     }
 
     // // scheduler start
@@ -508,11 +796,18 @@ public:
     {
         running = false;
 
-        cv.notify_all();
-
-        if (worker.joinable())
+        for (auto& shard : shards)
         {
-            worker.join();
+            // 持锁通知, 避免调度线程错过唤醒
+            {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+            }
+            shard->cv.notify_all();
+
+            if (shard->worker.joinable())
+            {
+                shard->worker.join();
+            }
         }
 
         consumer_running = false;
@@ -531,6 +826,81 @@ public:
         persistence = persistence_backend;
     }
 
+    // replace the executor that runs the jobs, only while stopped
+    void set_executor(std::unique_ptr<Executor> executor)
+    {
+        if (!executor)
+        {
+            throw std::runtime_error("Executor is null");
+        }
+        if (running)
+        {
+            throw std::runtime_error("Cannot replace executor while running");
+        }
+
+        // 旧执行器析构时会执行完剩余任务
+        thread_pool = std::move(executor);
+    }
+
+    // add a named executor pool, jobs assigned to it are isolated from
+    // the default pool, only while stopped
+    void add_executor_pool(
+        const std::string& name, size_t min_threads, size_t max_threads,
+        size_t max_queue = 0,
+        QueueFullPolicy full_policy = QueueFullPolicy::Reject)
+    {
+        std::unique_ptr<ThreadPool> pool;
+        try
+        {
+            pool = std::make_unique<ThreadPool>(min_threads, max_threads);
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error(
+                std::string("Failed to create thread pool: ") + e.what());
+        }
+        pool->set_max_queue(max_queue, full_policy);
+        add_executor(name, std::move(pool));
+    }
+
+    // add a named executor, only while stopped
+    void add_executor(const std::string& name,
+                      std::unique_ptr<Executor> executor)
+    {
+        if (!executor)
+        {
+            throw std::runtime_error("Executor is null");
+        }
+        if (running)
+        {
+            throw std::runtime_error("Cannot add executor while running");
+        }
+        if (name.empty() || name == DEFAULT_POOL || pool_index.count(name))
+        {
+            throw std::runtime_error("Executor pool " + name +
+                                     " already exists");
+        }
+
+        // 下标 0 为默认执行器
+        pools.emplace_back(std::move(executor));
+        pool_names.emplace_back(name);
+        pool_index.emplace(name, pools.size());
+    }
+
+    // get names of all executor pools, the default pool first
+    std::vector<std::string> get_pool_names() const
+    {
+        std::vector<std::string> names{DEFAULT_POOL};
+        names.insert(names.end(), pool_names.begin(), pool_names.end());
+        return names;
+    }
+
+    // get utilization and queue counters of an executor pool
+    ExecutorMetrics get_pool_metrics(const std::string& name) const
+    {
+        return executor_of(pool_of(name)).get_metrics();
+    }
+
     // void save_state()
     // {
     //     if (!persistence)
@@ -569,28 +939,23 @@ public:
         Job snapshot;
 
         {
-            std::lock_guard<std::mutex> lock(mutex);
+            auto& shard = shard_of(job_id);
+            std::lock_guard<std::mutex> lock(shard.mutex);
 
-            auto it = job_map.find(job_id);
-            if (it == job_map.end())
+            auto* job = shard.job_map.find(job_id);
+            if (job == nullptr)
             {
                 throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                          " not found");
             }
 
-            if (snapshot.deleted)
-            {
-                throw std::runtime_error("Job ID " + std::to_string(job_id) +
-                                         " is deleted");
-            }
-
-            if (snapshot.type == JobType::Immediate)
+            if (job->type == JobType::Immediate)
             {
                 throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                          " is immediate");
             }
 
-            snapshot = it->second;
+            snapshot = *job;
         }
 
         {
@@ -612,13 +977,14 @@ public:
         consumer();
 
         std::vector<Job> snapshot;
-        snapshot.reserve(job_map.size());
 
+        for (auto& shard : shards)
         {
-            std::lock_guard<std::mutex> lock(mutex);
-            for (const auto& [id, job] : job_map)
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            snapshot.reserve(snapshot.size() + shard->job_map.size());
+            for (const auto& job : shard->job_map)
             {
-                if (job.deleted || job.type == JobType::Immediate)
+                if (job.type == JobType::Immediate)
                 {
                     continue;
                 }
@@ -648,36 +1014,30 @@ public:
 
         std::vector<std::future<std::optional<std::pair<size_t, Job>>>> futures;
 
-        // 引入随机抖动 (0~4s)，避免集中处理任务
-        static thread_local std::mt19937 rng(std::random_device{}());
-        std::uniform_int_distribution<size_t> dist(jitter_min_ms,
-                                                   jitter_max_ms);
-
         for (size_t i = 0; i != jobs.size(); i++)
         {
             futures.emplace_back(std::async(
                 std::launch::async,
                 [&, i]() -> std::optional<std::pair<size_t, Job>> {
                     Job job = jobs[i];
-                    auto it = job_initializers_.find(job.id);
-                    if (it != job_initializers_.end())
+                    auto& shard = shard_of(job.id);
+                    auto it = shard.job_initializers_.find(job.id);
+                    if (it != shard.job_initializers_.end())
                     {
                         try
                         {
                             it->second(job);
-
-                            auto calculated_next = job.next;
-                            size_t attempt{0};
-                            do
+                            if (!job.time_zone)
                             {
-                                calculated_next =
-                                    cron::cron_next(job.expr, calculated_next);
-                                attempt++;
-                            } while (calculated_next <=
-                                         std::chrono::system_clock::now() &&
-                                     attempt < attempt_max);
-
-                            auto jitter = std::chrono::milliseconds(dist(rng));
+                                job.time_zone = zone_of("");
+                            }
+
+                            auto calculated_next = next_cron_time(
+                                job.expr, *job.time_zone, job.next);
+
+                            auto jitter = bound_jitter(
+                                job.expr, *job.time_zone, calculated_next,
+                                random_jitter());
                             job.next = calculated_next + jitter;
 
                             return std::make_pair(job.id, job);
@@ -699,42 +1059,52 @@ public:
                 }));
         }
 
-        std::unordered_map<size_t, Job> local_map;
-        std::queue<std::pair<size_t, std::chrono::system_clock::time_point>>
-            local_queue;
+        std::vector<std::unordered_map<size_t, Job>> local_maps(shards.size());
 
         for (auto& f : futures)
         {
             if (auto resp = f.get(); resp.has_value())
             {
                 const auto& [id, job] = resp.value();
-                local_map[id] = job;
-                local_queue.emplace(id, job.next);
+                local_maps[static_cast<uint32_t>(id) % shards.size()][id] = job;
             }
         }
 
+        for (size_t i = 0; i != shards.size(); i++)
         {
-            std::lock_guard<std::mutex> lock(mutex);
-            for (auto& [id, job] : local_map)
-            {
-                job_map[id] = std::move(job);
-            }
-            while (!local_queue.empty())
+            auto& shard = *shards[i];
+
             {
-                const auto& front = local_queue.front();
-                job_queue.emplace(front.first, front.second);
-                local_queue.pop();
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                for (auto& [id, job] : local_maps[i])
+                {
+                    // 槽内已有的任务 (可能是其他代数) 先完整移除
+                    if (uint64_t replaced = shard.job_map.occupant(id))
+                    {
+                        shard.job_queue->remove(replaced);
+                        leave_group(shard, replaced);
+                        if (replaced != id)
+                        {
+                            shard.job_initializers_.erase(replaced);
+                        }
+                        erase_job(shard, replaced);
+                    }
+                    shard.job_map.insert_at(id, std::move(job));
+                    count_job(shard, *shard.job_map.find(id), true);
+                    enqueue_job(shard, *shard.job_map.find(id));
+                }
             }
-        }
 
-        cv.notify_all();
+            shard.cv.notify_all();
+        }
     }
 
     void register_job_initializer(size_t job_id, JobInitializer initializer)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        if (job_map.find(job_id) == job_map.end())
+        if (!shard.job_map.contains(job_id))
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
@@ -742,22 +1112,23 @@ public:
 
         if (initializer)
         {
-            job_initializers_[job_id] = initializer;
+            shard.job_initializers_[job_id] = initializer;
         }
     }
 
     // get job status
     JobStatus get_job_status(size_t job_id)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = job_map.find(job_id);
-        if (it == job_map.end())
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
         }
-        return it->second.status;
+        return job->status;
     }
 
     // status to string
@@ -778,15 +1149,16 @@ public:
     // get job last result
     JobResult get_job_result(size_t job_id)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = job_map.find(job_id);
-        if (it == job_map.end())
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
         }
-        return it->second.result;
+        return job->result;
     }
 
     // result to string
@@ -807,200 +1179,1178 @@ public:
     // get job metrics
     JobMetrics get_job_metrics(size_t job_id)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        auto& shard = shard_of(job_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = job_map.find(job_id);
-        if (it == job_map.end())
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
         {
             throw std::runtime_error("Job ID " + std::to_string(job_id) +
                                      " not found");
         }
-        return it->second.metrics;
+        return job->metrics;
     }
 
-    // get job count
-    size_t get_job_count()
+    // next n fire times of a job after now, cron jobs in their zone without
+    // jitter, a once job its run time, an immediate job none
+    std::vector<std::chrono::system_clock::time_point>
+    get_next_fire_times(size_t job_id, size_t n)
     {
-        std::lock_guard<std::mutex> lock(mutex);
-
-        size_t count{0};
-        for (const auto& [id, job] : job_map)
+        cron::cronexpr expr;
+        std::shared_ptr<const TimeZone> zone;
+        std::vector<std::chrono::system_clock::time_point> times;
         {
-            if (!job.deleted)
+            auto& shard = shard_of(job_id);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto* job = shard.job_map.find(job_id);
+            if (job == nullptr)
             {
-                count++;
+                throw std::runtime_error("Job ID " + std::to_string(job_id) +
+                                         " not found");
             }
-        }
-        return count;
-    }
-
-    // get running job count
-    size_t get_running_job_count()
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-
-        size_t count{0};
-        for (const auto& [id, job] : job_map)
-        {
-            if (job.status == JobStatus::Running)
+            if (job->type != JobType::Cron)
             {
-                count++;
+                if (job->type == JobType::Once && n != 0)
+                {
+                    times.emplace_back(job->next);
+                }
+                return times;
             }
+            expr = job->expr;
+            zone = job->time_zone;
         }
 
-        return count;
+        // 锁外展开, 日历状态逐次推进
+        times.reserve(n);
+        cron::cron_next_n(expr, std::chrono::system_clock::now(), n,
+                          std::back_inserter(times), *zone);
+        return times;
     }
 
-    // get running
-    bool get_running() const
+    // get job count
+    size_t get_job_count() const
+    {
+        return sum_counter(&JobCounters::live);
+    }
+
+    // get running job count
+    size_t get_running_job_count() const
+    {
+        return sum_counter(&JobCounters::running);
+    }
+
+    // get paused job count
+    size_t get_paused_job_count() const
+    {
+        return sum_counter(&JobCounters::paused);
+    }
+
+    // get number of fires missed by more than the misfire threshold
+    size_t get_misfire_count() const
+    {
+        return sum_counter(&JobCounters::misfired);
+    }
+
+    // get number of fire groups
+    size_t get_fire_group_count()
+    {
+        size_t count{0};
+        for (auto& shard : shards)
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+
+            count += shard->group_index.size();
+        }
+        return count;
+    }
+
+    // get number of detected wall clock jumps
+    size_t get_clock_jump_count() const
+    {
+        return clock_jump_count;
+    }
+
+    using WallClock = std::function<std::chrono::system_clock::time_point()>;
+
+    // wall clock watched for jumps, system_clock by default
+    void set_wall_clock(WallClock clock)
+    {
+        std::lock_guard<std::mutex> lock(clock_mutex);
+        wall_clock = std::move(clock);
+    }
+
+    // get number of executor worker threads
+    size_t get_thread_count() const
+    {
+        return thread_pool->get_thread_count();
+    }
+
+    // get running
+    bool get_running() const
     {
         return running;
     }
 
 private:
-    // process_job
-    void process_job(const JobNode& node)
+    /*
+     * clock anchor
+     * Description: a wall clock time and the monotonic time it was taken at,
+     *              queue deadlines are wall times mapped through it
+     */
+    struct ClockAnchor
+    {
+        std::chrono::system_clock::time_point wall;
+        std::chrono::steady_clock::time_point steady;
+        size_t epoch;
+    };
+
+    /*
+     * fire group
+     * Description: cron jobs sharing one expression, the queue holds one
+     *              node for the whole group and cron_next runs once per fire
+     */
+    struct FireGroup
+    {
+        cron::cronexpr expr;
+        // expression and zone name, the index key of the group
+        std::string key;
+        std::shared_ptr<const TimeZone> time_zone;
+        std::chrono::system_clock::time_point next;
+        std::vector<size_t> members;
+    };
+
+    struct GroupMember
+    {
+        size_t group_id;
+        size_t index;
+    };
+
+    struct JobCounters
+    {
+        std::atomic<size_t> live{0};
+        std::atomic<size_t> running{0};
+        std::atomic<size_t> paused{0};
+        std::atomic<size_t> misfired{0};
+    };
+
+    /*
+     * job run
+     * Description: task and callbacks moved out of a running job, the job
+     *              itself stays in the slot map and is found again by id,
+     *              recycled per shard so posting a run allocates nothing
+     */
+    struct JobRun
     {
-        Job* job_ptr;
+        size_t id;
+        size_t runs;
+        JobPriority priority;
+        size_t pool;
+        Task task;
+        AsyncStart async_start;
+        StartCallback start_callback;
+        SuccessCallback success_callback;
+        ErrorCallback error_callback;
+        EndCallback end_callback;
+    };
+
+    /*
+     * shard
+     * Description: job ids are spread over shards, each shard owns its
+     *              jobs, queue, lock and dispatcher thread
+     */
+    struct Shard
+    {
+        Shard(uint32_t stride, uint32_t offset) : job_map(stride, offset)
+        {}
+
+        std::unique_ptr<JobQueue> job_queue;
+        SlotMap<Job> job_map;
+        std::unordered_map<size_t, JobInitializer> job_initializers_;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::thread worker;
+        ClockAnchor anchor;
+        JobCounters counters;
+
+        std::vector<FireGroup> groups;
+        std::vector<size_t> free_groups;
+        std::unordered_map<std::string, size_t> group_index;
+        std::unordered_map<size_t, GroupMember> job_groups;
+
+        std::vector<std::unique_ptr<JobRun>> free_runs;
+    };
+
+    /*
+     * run task
+     * Description: closure posted to an executor, a run that is rejected or
+     *              dropped before it starts is finished as failed
+     */
+    struct RunTask
+    {
+        RunTask(ChronixScheduler* scheduler, Shard* shard, JobRun* run)
+            : scheduler(scheduler), shard(shard), run(run)
+        {}
+
+        RunTask(RunTask&& other) noexcept
+            : scheduler(other.scheduler),
+              shard(other.shard),
+              run(std::exchange(other.run, nullptr))
+        {}
 
+        RunTask(const RunTask&) = delete;
+        RunTask& operator=(const RunTask&) = delete;
+        RunTask& operator=(RunTask&&) = delete;
+
+        ~RunTask()
         {
-            std::lock_guard<std::mutex> lock(mutex);
+            if (run != nullptr)
+            {
+                scheduler->finish_job(*shard, *run, JobResult::Failed,
+                                      std::chrono::milliseconds(0));
+            }
+        }
+
+        void operator()()
+        {
+            scheduler->run_job(*shard, *std::exchange(run, nullptr));
+        }
+
+        ChronixScheduler* scheduler;
+        Shard* shard;
+        JobRun* run;
+    };
+
+#ifdef CHRONIX_COROUTINES
+    // each run calls job for a new coroutine and starts it on the pool
+    AsyncStart make_async_start(AsyncJob job)
+    {
+        if (!job)
+        {
+            throw std::runtime_error("AsyncJob is empty");
+        }
+
+        return [this, job = std::move(job)](
+                   size_t pool,
+                   unique_function<void(std::exception_ptr)> done) {
+            job().start(AsyncContext{&executor_of(pool), &async_timer},
+                        std::move(done));
+        };
+    }
+#endif
+
+    // 引入随机抖动，避免集中处理任务
+    // 引擎按线程独立, load_state 的异步加载线程也可并发调用
+    std::chrono::milliseconds random_jitter()
+    {
+        static thread_local std::mt19937 rng(std::random_device{}());
+        std::uniform_int_distribution<size_t> dist(jitter_min_ms,
+                                                   jitter_max_ms);
+        return std::chrono::milliseconds(dist(rng));
+    }
 
-            auto it = job_map.find(node.id);
-            if (it == job_map.end())
+    // 每个调度线程独占一个核心, 任务状态留在该核心的缓存中
+    void pin_dispatchers()
+    {
+        std::lock_guard<std::mutex> lock(affinity_mutex);
+        if (dispatcher_cpus.empty())
+        {
+            return;
+        }
+        for (size_t i = 0; i != shards.size(); i++)
+        {
+            if (shards[i]->worker.joinable())
             {
-                return;
+                pin_thread(shards[i]->worker.native_handle(),
+                           {dispatcher_cpus[i % dispatcher_cpus.size()]});
             }
+        }
+    }
+
+    // pool index of a pool name, 0 for the default pool
+    size_t pool_of(const std::string& name) const
+    {
+        if (name.empty() || name == DEFAULT_POOL)
+        {
+            return 0;
+        }
+
+        auto it = pool_index.find(name);
+        if (it == pool_index.end())
+        {
+            throw std::runtime_error("Executor pool " + name + " not found");
+        }
+        return it->second;
+    }
 
-            auto& job = it->second;
-            if (job.deleted)
+    Executor& executor_of(size_t pool) const
+    {
+        return pool == 0 ? *thread_pool : *pools[pool - 1];
+    }
+
+    // wall clock job time to a queue deadline, shard lock held
+    std::chrono::steady_clock::time_point to_deadline(
+        Shard& shard, std::chrono::system_clock::time_point wall)
+    {
+        using steady_duration = std::chrono::steady_clock::duration;
+        auto offset = wall - shard.anchor.wall;
+        return shard.anchor.steady +
+               std::chrono::duration_cast<steady_duration>(offset);
+    }
+
+    // detect wall clock jumps and re-anchor the queue, shard lock held
+    void sync_clock(Shard& shard)
+    {
+        {
+            std::lock_guard<std::mutex> lock(clock_mutex);
+
+            auto wall = wall_clock();
+            auto steady = std::chrono::steady_clock::now();
+
+            // 两个时钟走过的时间之差
+            auto drift =
+                (wall - clock_anchor.wall) - (steady - clock_anchor.steady);
+            if (drift > clock_jump_threshold || drift < -clock_jump_threshold)
             {
-                job_map.erase(it);
-                return;
+                clock_anchor =
+                    ClockAnchor{wall, steady, clock_anchor.epoch + 1};
+                clock_jump_count++;
             }
 
-            if (job.status != JobStatus::Pending)
+            if (shard.anchor.epoch == clock_anchor.epoch)
             {
-                // 非Peding状态 & 周期性任务 下次继续调度
-                if (job.type == JobType::Cron)
-                {
-                    auto calculated_next = job.next;
-                    size_t attempt{0};
-                    do
-                    {
-                        calculated_next =
-                            cron::cron_next(job.expr, calculated_next);
-                        attempt++;
-                    } while (calculated_next <=
-                                 std::chrono::system_clock::now() &&
-                             attempt < attempt_max);
-
-                    job.next = calculated_next;
-                    job_queue.emplace(job.id, calculated_next);
-                    cv.notify_one();
-                }
                 return;
             }
+            shard.anchor = clock_anchor;
+        }
 
-            // 是Pending状态
-            job_ptr = &job;
-            job_ptr->status = JobStatus::Running;
-            job.status = JobStatus::Running;
+        // 按新的对应关系重算已入队任务的截止时间
+        for (const auto& job : shard.job_map)
+        {
+            if (job.status == JobStatus::Pending &&
+                !shard.job_groups.count(job.id))
+            {
+                shard.job_queue->push(
+                    JobNode(job.id, to_deadline(shard, job.next)));
+            }
         }
+        for (size_t group_id = 0; group_id != shard.groups.size(); group_id++)
+        {
+            if (!shard.groups[group_id].members.empty())
+            {
+                shard.job_queue->push(JobNode(
+                    group_id, to_deadline(shard, shard.groups[group_id].next)));
+            }
+        }
+    }
 
-        // 准备任务包装器
-        auto wrapped_task = [this, job_ptr]() {
-            auto& job = *job_ptr;
-            auto start_time = std::chrono::system_clock::now();
+    // 低32位按分片数交错分配, 见 SlotMap
+    Shard& shard_of(size_t job_id)
+    {
+        return *shards[static_cast<uint32_t>(job_id) % shards.size()];
+    }
 
-            try
+    // new jobs are spread over shards round robin
+    Shard& next_shard()
+    {
+        return *shards[next_shard_index++ % shards.size()];
+    }
+
+    // insert a job into the slot map, shard lock held
+    size_t insert_job(Shard& shard, Job job)
+    {
+        size_t job_id = shard.job_map.insert(std::move(job));
+        auto* inserted = shard.job_map.find(job_id);
+        inserted->id = job_id;
+        count_job(shard, *inserted, true);
+        return job_id;
+    }
+
+    // erase a job from the slot map, shard lock held
+    void erase_job(Shard& shard, size_t job_id)
+    {
+        if (auto* job = shard.job_map.find(job_id))
+        {
+            count_job(shard, *job, false);
+            shard.job_map.erase(job_id);
+        }
+    }
+
+    // 每次状态变更都维护计数, 读取时无需加锁
+    void set_status(Shard& shard, Job& job, JobStatus status)
+    {
+        count_job(shard, job, false);
+        job.status = status;
+        count_job(shard, job, true);
+    }
+
+    void count_job(Shard& shard, const Job& job, bool add)
+    {
+        auto& counters = shard.counters;
+        auto update = [add](std::atomic<size_t>& counter) {
+            if (add)
+            {
+                counter.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                counter.fetch_sub(1, std::memory_order_relaxed);
+            }
+        };
+
+        update(counters.live);
+        if (job.status == JobStatus::Running)
+        {
+            update(counters.running);
+        }
+        else if (job.status == JobStatus::Paused)
+        {
+            update(counters.paused);
+        }
+    }
+
+    // 按分片计数, 读取时求和, 无需加锁
+    size_t sum_counter(std::atomic<size_t> JobCounters::*counter) const
+    {
+        size_t count{0};
+        for (const auto& shard : shards)
+        {
+            count += (shard->counters.*counter).load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    bool is_grouped(const Job& job) const
+    {
+        return fire_groups_enabled && job.type == JobType::Cron;
+    }
+
+    // 任务ID的代数从1开始, 低于 2^32 的队列ID留给触发组
+    static bool is_group_id(size_t queue_id)
+    {
+        return (queue_id >> 32) == 0;
+    }
+
+    // queue a pending job, shard lock held
+    void enqueue_job(Shard& shard, Job& job)
+    {
+        if (is_grouped(job))
+        {
+            join_group(shard, job);
+            return;
+        }
+        shard.job_queue->push(JobNode(job.id, to_deadline(shard, job.next)));
+    }
+
+    // join the fire group of the job's expression and zone, shard lock held
+    void join_group(Shard& shard, Job& job)
+    {
+        auto member = shard.job_groups.find(job.id);
+        if (member != shard.job_groups.end())
+        {
+            job.next = shard.groups[member->second.group_id].next;
+            return;
+        }
+
+        size_t group_id;
+        std::string key = job.expr_str + " " + job.time_zone->name();
+        auto it = shard.group_index.find(key);
+        if (it != shard.group_index.end())
+        {
+            group_id = it->second;
+        }
+        else
+        {
+            if (!shard.free_groups.empty())
+            {
+                group_id = shard.free_groups.back();
+                shard.free_groups.pop_back();
+            }
+            else
             {
-                if (job.start_callback)
+                group_id = shard.groups.size();
+                shard.groups.emplace_back();
+            }
+
+            auto& group = shard.groups[group_id];
+            group.expr = job.expr;
+            group.key = key;
+            group.time_zone = job.time_zone;
+            group.next = next_cron_time(job.expr, *job.time_zone,
+                                        std::chrono::system_clock::now());
+            shard.group_index.emplace(std::move(key), group_id);
+            shard.job_queue->push(
+                JobNode(group_id, to_deadline(shard, group.next)));
+        }
+
+        auto& group = shard.groups[group_id];
+        shard.job_groups.emplace(job.id,
+                                 GroupMember{group_id, group.members.size()});
+        group.members.emplace_back(job.id);
+        job.next = group.next;
+    }
+
+    // leave the fire group, the last member releases it, shard lock held
+    void leave_group(Shard& shard, size_t job_id)
+    {
+        auto member = shard.job_groups.find(job_id);
+        if (member == shard.job_groups.end())
+        {
+            return;
+        }
+
+        auto [group_id, index] = member->second;
+        shard.job_groups.erase(member);
+
+        auto& group = shard.groups[group_id];
+        if (index != group.members.size() - 1)
+        {
+            group.members[index] = group.members.back();
+            shard.job_groups[group.members[index]].index = index;
+        }
+        group.members.pop_back();
+
+        if (group.members.empty())
+        {
+            shard.job_queue->remove(group_id);
+            shard.group_index.erase(group.key);
+            group = FireGroup{};
+            shard.free_groups.emplace_back(group_id);
+        }
+    }
+
+    // dispatcher of one shard
+    void dispatch(Shard& shard)
+    {
+        while (running)
+        {
+            std::vector<JobNode> ready_nodes;
+            std::vector<JobRun*> ready_runs;
+
+            {
+                std::unique_lock<std::mutex> lock(shard.mutex);
+
+                if (!running)
                 {
-                    job.start_callback(job.id);
+                    break;
                 }
 
-                job.task();
+                sync_clock(shard);
 
+                if (shard.job_queue->empty())
                 {
-                    std::lock_guard<std::mutex> lock(mutex);
+                    shard.cv.wait(lock);
+                    continue;
+                }
 
-                    job.status = JobStatus::Pending;
-                    job.result = JobResult::Success;
+                auto now = std::chrono::steady_clock::now();
+                shard.job_queue->pop_expired(now, ready_nodes);
 
-                    if (metrics_enabled)
+                if (ready_nodes.empty())
+                {
+                    // 定期醒来检查墙上时间是否跳变
+                    auto next_wake = std::min(shard.job_queue->next_wake(),
+                                              now + clock_check_interval);
+                    if (next_wake > now)
                     {
-                        auto duration = std::chrono::duration_cast<
-                            std::chrono::milliseconds>(
-                            std::chrono::system_clock::now() - start_time);
-                        job.metrics.update(true, duration);
+                        shard.cv.wait_until(lock, next_wake);
                     }
+                    continue;
                 }
 
-                if (job.success_callback)
+                // 在调度线程内解析任务状态, 每个任务只投递一次
+                for (auto& node : ready_nodes)
                 {
-                    job.success_callback(job.id);
+                    if (is_group_id(node.id))
+                    {
+                        fire_group(shard, node.id, ready_runs);
+                        continue;
+                    }
+                    prepare_job(shard, node.id, ready_runs);
                 }
             }
-            catch (const std::exception& e)
+
+            // 相同执行器和优先级的连续任务一次投递, 一次加锁一次唤醒
+            std::vector<unique_function<void()>> batch;
+            for (size_t i = 0; i != ready_runs.size();)
             {
+                size_t pool = ready_runs[i]->pool;
+                JobPriority priority = ready_runs[i]->priority;
+                for (; i != ready_runs.size() &&
+                       ready_runs[i]->pool == pool &&
+                       ready_runs[i]->priority == priority;
+                     i++)
                 {
-                    std::lock_guard<std::mutex> lock(mutex);
+                    batch.emplace_back(RunTask(this, &shard, ready_runs[i]));
+                }
 
-                    job.status = JobStatus::Pending;
-                    job.result = JobResult::Failed;
+                try
+                {
+                    executor_of(pool).post_bulk(batch, priority);
+                }
+                catch (const std::exception&)
+                {
+                    // 未投递的 RunTask 析构时结束本次执行, 周期任务照常排期
+                }
+                batch.clear();
+            }
+        }
+    }
 
-                    if (metrics_enabled)
-                    {
-                        auto duration = std::chrono::duration_cast<
-                            std::chrono::milliseconds>(
-                            std::chrono::system_clock::now() - start_time);
-                        job.metrics.update(false, duration);
-                    }
+    // fan a due group out to its pending members and re-arm it once
+    void fire_group(Shard& shard, size_t group_id, std::vector<JobRun*>& out)
+    {
+        auto& group = shard.groups[group_id];
+        auto now = std::chrono::system_clock::now();
+
+        // 整组只统计一次错过的触发, 成员按各自策略决定执行次数
+        size_t missed{0};
+        auto last = group.next;
+        if (now - group.next > misfire_threshold)
+        {
+            missed = count_missed(group.expr, *group.time_zone, last, now);
+            group.next = cron::cron_next(group.expr, now, *group.time_zone);
+        }
+        else
+        {
+            group.next =
+                cron::cron_next(group.expr, group.next, *group.time_zone);
+        }
+
+        // 仍在运行的成员错过本次触发
+        for (auto job_id : group.members)
+        {
+            auto* job = shard.job_map.find(job_id);
+            job->next = group.next;
+            if (job->status != JobStatus::Pending)
+            {
+                continue;
+            }
+
+            size_t runs = 1;
+            if (missed != 0)
+            {
+                runs = misfire_runs(shard, *job, missed);
+            }
+            if (runs != 0)
+            {
+                start_job(shard, *job, runs, out);
+            }
+        }
+
+        shard.job_queue->push(
+            JobNode(group_id, to_deadline(shard, group.next)));
+    }
+
+    // resolve a due node under the shard lock, skipped if it must not run
+    void prepare_job(Shard& shard, size_t job_id, std::vector<JobRun*>& out)
+    {
+        auto* job = shard.job_map.find(job_id);
+        if (job == nullptr)
+        {
+            return;
+        }
+
+        // 出队后被暂停, 恢复时会重新入队
+        if (job->status != JobStatus::Pending)
+        {
+            return;
+        }
+
+        size_t runs = 1;
+        auto now = std::chrono::system_clock::now();
+        if (job->type == JobType::Cron && now - job->next > misfire_threshold)
+        {
+            auto last = job->next;
+            size_t missed =
+                count_missed(job->expr, *job->time_zone, last, now);
+            runs = misfire_runs(shard, *job, missed);
+
+            // 补跑全部时从最后一次错过的时间继续, 否则从现在继续
+            job->next = runs > 1 ? last : now;
+            if (runs == 0)
+            {
+                job->next = cron::cron_next(job->expr, now, *job->time_zone);
+                shard.job_queue->push(
+                    JobNode(job_id, to_deadline(shard, job->next)));
+                return;
+            }
+        }
+
+        start_job(shard, *job, runs, out);
+    }
+
+    // 一次遍历统计 [last, now] 内错过的触发, last 返回最后一次
+    size_t count_missed(const cron::cronexpr& expr, const TimeZone& zone,
+                        std::chrono::system_clock::time_point& last,
+                        std::chrono::system_clock::time_point now)
+    {
+        size_t missed{1};
+        for (auto next : cron::cron_between(expr, last, now, zone))
+        {
+            if (missed >= catch_up_max)
+            {
+                break;
+            }
+            last = next;
+            missed++;
+        }
+        return missed;
+    }
+
+    // record missed fires and return how many runs the policy allows
+    size_t misfire_runs(Shard& shard, Job& job, size_t missed)
+    {
+        shard.counters.misfired.fetch_add(missed, std::memory_order_relaxed);
+        job.metrics.misfire_count += missed;
+
+        switch (job.misfire_policy)
+        {
+        case MisfirePolicy::FireOnce:
+            return 1;
+        case MisfirePolicy::FireAll:
+            return missed;
+        case MisfirePolicy::Skip:
+            return 0;
+        }
+        return 1;
+    }
+
+    // 运行期间不持有 Job 指针, 任务和回调移出, 结束后归还
+    void start_job(Shard& shard, Job& job, size_t runs,
+                   std::vector<JobRun*>& out)
+    {
+        set_status(shard, job, JobStatus::Running);
+
+        JobRun* run = acquire_run(shard);
+        run->id = job.id;
+        run->runs = runs;
+        run->priority = job.priority;
+        run->pool = job.pool;
+        run->task = std::move(job.task);
+        run->async_start = std::move(job.async_start);
+        run->start_callback = std::move(job.start_callback);
+        run->success_callback = std::move(job.success_callback);
+        run->error_callback = std::move(job.error_callback);
+        run->end_callback = std::move(job.end_callback);
+        out.emplace_back(run);
+    }
+
+    // take a run object from the shard pool, shard lock held
+    JobRun* acquire_run(Shard& shard)
+    {
+        if (shard.free_runs.empty())
+        {
+            return new JobRun{};
+        }
+        JobRun* run = shard.free_runs.back().release();
+        shard.free_runs.pop_back();
+        return run;
+    }
+
+    // give a run object back to the shard pool, shard lock held
+    void release_run(Shard& shard, JobRun* run)
+    {
+        // 清空残留的任务和回调, 及时释放其捕获的资源
+        run->task = nullptr;
+        run->async_start = nullptr;
+        run->start_callback = nullptr;
+        run->success_callback = nullptr;
+        run->error_callback = nullptr;
+        run->end_callback = nullptr;
+
+        if (shard.free_runs.size() < run_pool_max)
+        {
+            shard.free_runs.emplace_back(run);
+            return;
+        }
+        delete run;
+    }
+
+    // run a prepared job on an executor thread, catch-up runs back to back
+    void run_job(Shard& shard, JobRun& run)
+    {
+        if (run.async_start)
+        {
+            run_async(shard, run, 0);
+            return;
+        }
+
+        for (size_t i = 0; i != run.runs; i++)
+        {
+            auto start_time = std::chrono::system_clock::now();
+            auto result = JobResult::Success;
+            std::chrono::milliseconds duration{0};
+
+            try
+            {
+                if (run.start_callback)
+                {
+                    run.start_callback(run.id);
                 }
 
-                if (job.error_callback)
+                run.task();
+
+                duration =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now() - start_time);
+
+                if (run.success_callback)
                 {
-                    job.error_callback(job.id, e);
+                    run.success_callback(run.id);
                 }
             }
+            catch (const std::exception& e)
+            {
+                result = JobResult::Failed;
+                duration =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now() - start_time);
+                invoke_callback(run.error_callback, run.id, e);
+            }
+            catch (...)
+            {
+                result = JobResult::Failed;
+                duration =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now() - start_time);
+                invoke_callback(run.error_callback, run.id,
+                                std::runtime_error("Unknown exception"));
+            }
 
-            if (job.end_callback)
+            invoke_callback(run.end_callback, run.id);
+
+            if (i + 1 == run.runs)
             {
-                job.end_callback(job.id);
+                finish_job(shard, run, result, duration);
             }
+            else
+            {
+                record_run(shard, run, result, duration);
+            }
+        }
+    }
 
-            if (job.type == JobType::Once || job.type == JobType::Immediate)
+    // error 与 end 回调在任务的 catch 之外调用, 它们抛出会跳过
+    // finish_job, 任务永远停在 Running; 本次结果已定, 回调的失败只能忽略
+    template <typename Callback, typename... Args>
+    static void invoke_callback(Callback& callback, Args&&... args) noexcept
+    {
+        if (!callback)
+        {
+            return;
+        }
+        try
+        {
+            callback(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+        }
+    }
+
+    // metrics of a catch-up run that is not the last one
+    void record_run(Shard& shard, JobRun& run, JobResult result,
+                    std::chrono::milliseconds duration)
+    {
+        if (!metrics_enabled)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (auto* job = shard.job_map.find(run.id))
+        {
+            job->metrics.update(result == JobResult::Success, duration);
+        }
+    }
+
+    // start one run of a coroutine job, the worker is released at its first
+    // suspension and the next catch-up run starts when it completes
+    void run_async(Shard& shard, JobRun& run, size_t index)
+    {
+        auto start_time = std::chrono::system_clock::now();
+        try
+        {
+            if (run.start_callback)
             {
-                std::lock_guard<std::mutex> lock(mutex);
+                run.start_callback(run.id);
+            }
 
-                job_map.erase(job.id);
+            // 协程可能在返回前已在其他线程结束并回收 run, 之后不再访问 run
+            run.async_start(run.pool, [this, &shard, &run, index, start_time](
+                                          std::exception_ptr error) {
+                complete_async(shard, run, index, start_time, error);
+            });
+        }
+        catch (...)
+        {
+            complete_async(shard, run, index, start_time,
+                           std::current_exception());
+        }
+    }
+
+    // callbacks and bookkeeping of a finished coroutine run, on the thread
+    // that resumed it last
+    void complete_async(Shard& shard, JobRun& run, size_t index,
+                        std::chrono::system_clock::time_point start_time,
+                        std::exception_ptr error)
+    {
+        auto result = JobResult::Success;
+        bool rejected{false};
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+
+        try
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
             }
-            else
+            if (run.success_callback)
             {
-                std::lock_guard<std::mutex> lock(mutex);
+                run.success_callback(run.id);
+            }
+        }
+#ifdef CHRONIX_COROUTINES
+        catch (const ResumeRejected& e)
+        {
+            result = JobResult::Failed;
+            rejected = true;
+            invoke_callback(run.error_callback, run.id, e);
+        }
+#endif
+        catch (const std::exception& e)
+        {
+            result = JobResult::Failed;
+            invoke_callback(run.error_callback, run.id, e);
+        }
+        catch (...)
+        {
+            result = JobResult::Failed;
+            invoke_callback(run.error_callback, run.id,
+                            std::runtime_error("Unknown exception"));
+        }
+
+        invoke_callback(run.end_callback, run.id);
+
+        // 析构期间不再开始新的补跑, 执行器拒绝恢复时当前线程可能是定时器
+        if (index + 1 == run.runs || async_closing || rejected)
+        {
+            finish_job(shard, run, result, duration);
+            return;
+        }
+        record_run(shard, run, result, duration);
+        run_async(shard, run, index + 1);
+    }
+
+    // hand a finished job back to its shard and recycle the run
+    void finish_job(Shard& shard, JobRun& run, JobResult result,
+                    std::chrono::milliseconds duration)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        restore_job(shard, run, result, duration);
+        release_run(shard, &run);
+    }
+
+    // put the task and callbacks back and re-arm, shard lock held
+    void restore_job(Shard& shard, JobRun& run, JobResult result,
+                     std::chrono::milliseconds duration)
+    {
+        auto* job = shard.job_map.find(run.id);
+        if (job == nullptr)
+        {
+            return;
+        }
 
-                if (!job.deleted)
+        set_status(shard, *job, JobStatus::Pending);
+        job->result = result;
+
+        if (metrics_enabled)
+        {
+            job->metrics.update(result == JobResult::Success, duration);
+        }
+
+        if (job->type == JobType::Once || job->type == JobType::Immediate)
+        {
+            erase_job(shard, run.id);
+            return;
+        }
+
+        // 运行期间设置的回调优先
+        job->task = std::move(run.task);
+        job->async_start = std::move(run.async_start);
+        if (!job->start_callback)
+        {
+            job->start_callback = std::move(run.start_callback);
+        }
+        if (!job->success_callback)
+        {
+            job->success_callback = std::move(run.success_callback);
+        }
+        if (!job->error_callback)
+        {
+            job->error_callback = std::move(run.error_callback);
+        }
+        if (!job->end_callback)
+        {
+            job->end_callback = std::move(run.end_callback);
+        }
+
+        // 触发组统一计算下次时间, 已过期的触发由出队时的错过策略处理
+        if (!shard.job_groups.count(run.id))
+        {
+            auto calculated_next =
+                cron::cron_next(job->expr, job->next, *job->time_zone);
+
+            job->next = calculated_next;
+            shard.job_queue->push(
+                JobNode(run.id, to_deadline(shard, calculated_next)));
+            shard.cv.notify_one();
+        }
+    }
+
+    static Job make_job(JobType type, const cron::cronexpr& expr,
+                        const std::string& expr_str, Task task,
+                        std::chrono::system_clock::time_point next,
+                        JobPriority priority = JobPriority::Normal,
+                        size_t pool = 0,
+                        std::shared_ptr<const TimeZone> time_zone = nullptr)
+    {
+        Job job{
+            0,
+            expr,
+            expr_str,
+            std::move(time_zone),
+            std::move(task),
+            next,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr,
+            JobStatus::Pending,
+            JobResult::Unknown,
+            type,
+        };
+        job.priority = priority;
+        job.pool = pool;
+        return job;
+    }
+
+    // 右值范围的元素可以移走, 左值范围只能复制
+    template <typename Range, typename T>
+    static T forward_element(T& element)
+    {
+        if constexpr (std::is_lvalue_reference_v<Range>)
+        {
+            return element;
+        }
+        else
+        {
+            return std::move(element);
+        }
+    }
+
+    // 批量注册: 按分片轮转分配, 每个分片只加锁和唤醒一次
+    std::vector<size_t> add_jobs(std::vector<Job>& jobs)
+    {
+        std::vector<size_t> ids(jobs.size());
+        if (jobs.empty())
+        {
+            return ids;
+        }
+
+        size_t first_shard = next_shard_index.fetch_add(jobs.size());
+
+        std::vector<std::vector<size_t>> shard_indexes(shards.size());
+        for (size_t i = 0; i != jobs.size(); i++)
+        {
+            shard_indexes[(first_shard + i) % shards.size()].emplace_back(i);
+        }
+
+        for (size_t s = 0; s != shards.size(); s++)
+        {
+            const auto& indexes = shard_indexes[s];
+            if (indexes.empty())
+            {
+                continue;
+            }
+
+            std::vector<JobNode> nodes;
+            nodes.reserve(indexes.size());
+
+            auto& shard = *shards[s];
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.job_map.reserve(shard.job_map.size() + indexes.size());
+                for (auto i : indexes)
                 {
-                    auto calculated_next = job.next;
-                    size_t attempt{0};
-                    do
+                    ids[i] = insert_job(shard, std::move(jobs[i]));
+
+                    auto& job = *shard.job_map.find(ids[i]);
+                    if (is_grouped(job))
                     {
-                        calculated_next =
-                            cron::cron_next(job.expr, calculated_next);
-                        attempt++;
-                    } while (calculated_next <=
-                                 std::chrono::system_clock::now() &&
-                             attempt < attempt_max);
-
-                    job.next = calculated_next;
-                    job_queue.emplace(job.id, calculated_next);
-                    cv.notify_one();
+                        join_group(shard, job);
+                        continue;
+                    }
+                    nodes.emplace_back(ids[i], to_deadline(shard, job.next));
                 }
+                shard.job_queue->push_bulk(nodes);
             }
-        };
 
-        thread_pool->submit(wrapped_task);
+            shard.cv.notify_one();
+        }
+
+        return ids;
+    }
+
+    // zone by name, the default zone if empty
+    std::shared_ptr<const TimeZone> zone_of(const std::string& name)
+    {
+        if (!name.empty())
+        {
+            return TimeZone::locate(name);
+        }
+        std::lock_guard<std::mutex> lock(time_zone_mutex);
+        return time_zone;
+    }
+
+    // jitter of a cron job, kept below the gap to its following fire so a
+    // sub-second job does not skip runs
+    std::chrono::system_clock::duration
+    bound_jitter(const cron::cronexpr& expr, const TimeZone& zone,
+                 std::chrono::system_clock::time_point next,
+                 std::chrono::milliseconds jitter)
+    {
+        if (jitter.count() == 0)
+        {
+            return jitter;
+        }
+
+        // 抖动只推迟首次触发, 之后按表达式的相位触发
+        auto gap = cron::cron_next(expr, next, zone) - next;
+        if (gap > std::chrono::system_clock::duration::zero() && jitter >= gap)
+        {
+            return jitter % gap;
+        }
+        return jitter;
+    }
+
+    // next cron time after from, skipping times that have already passed
+    std::chrono::system_clock::time_point next_cron_time(
+        const cron::cronexpr& expr, const TimeZone& zone,
+        std::chrono::system_clock::time_point from)
+    {
+        auto calculated_next = from;
+        size_t attempt{0};
+        do
+        {
+            calculated_next = cron::cron_next(expr, calculated_next, zone);
+            attempt++;
+        } while (calculated_next <= std::chrono::system_clock::now() &&
+                 attempt < attempt_max);
+
+        return calculated_next;
     }
 
     void consumer()
@@ -1038,23 +2388,34 @@ private:
         });
     }
 
-    std::priority_queue<JobNode, std::vector<JobNode>, std::greater<JobNode>>
-        job_queue;
-    std::unordered_map<size_t, Job> job_map;
-    std::thread worker;
+    std::vector<std::unique_ptr<Shard>> shards;
     std::atomic<bool> running;
-    std::atomic<size_t> next_job_id;
-    std::mutex mutex;
+    std::atomic<size_t> next_shard_index;
 
-    std::unique_ptr<ThreadPool> thread_pool;
+    std::unique_ptr<Executor> thread_pool;
 
-    std::shared_ptr<Persistence<Job>> persistence;
+    // 命名执行器池, 下标加一即为任务的 pool
+    std::vector<std::unique_ptr<Executor>> pools;
+    std::vector<std::string> pool_names;
+    std::unordered_map<std::string, size_t> pool_index;
 
-    std::unordered_map<size_t, JobInitializer> job_initializers_;
+#ifdef CHRONIX_COROUTINES
+    // 挂起的协程任务在此等待, 先于执行器析构
+    AsyncTimer async_timer;
+#endif
+    std::atomic<bool> async_closing{false};
 
-    std::atomic<bool> metrics_enabled;
+    std::vector<size_t> dispatcher_cpus;
+    std::mutex affinity_mutex;
+
+    // 只在添加任务时读取, 调度线程使用任务自带的时区
+    std::shared_ptr<const TimeZone> time_zone{TimeZone::local()};
+    std::mutex time_zone_mutex;
+
+    std::shared_ptr<Persistence<Job>> persistence;
 
-    std::condition_variable cv;
+    std::atomic<bool> metrics_enabled;
+    std::atomic<bool> fire_groups_enabled{false};
 
     std::queue<std::vector<Job>> consumer_queue;
     std::mutex consumer_mutex;
@@ -1062,7 +2423,17 @@ private:
     std::condition_variable consumer_cv;
     std::atomic<bool> consumer_running;
 
+    ClockAnchor clock_anchor;
+    WallClock wall_clock{[]() { return std::chrono::system_clock::now(); }};
+    std::mutex clock_mutex;
+    std::atomic<size_t> clock_jump_count{0};
+    std::chrono::milliseconds clock_jump_threshold{1000};
+    std::chrono::milliseconds clock_check_interval{1000};
+
     size_t jitter_max_ms{500};
     size_t jitter_min_ms{0};
     size_t attempt_max{10};
+    size_t catch_up_max{100};
+    size_t run_pool_max{1024};
+    std::chrono::milliseconds misfire_threshold{1000};
 };
@@ -0,0 +1,498 @@
+#pragma once
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "chronix/thread_pool/executor.h"
+
+#define CHRONIX_COROUTINES 1
+
+class AsyncTimer;
+
+// where a suspended job resumes: the executor of its pool and the timer
+struct AsyncContext
+{
+    Executor* executor{nullptr};
+    AsyncTimer* timer{nullptr};
+};
+
+/*
+ * resume rejected
+ * Description: error a coroutine job finishes with when the executor
+ *              refuses or drops the task that would resume it
+ */
+struct ResumeRejected : std::runtime_error
+{
+    ResumeRejected() : std::runtime_error("Executor rejected the resumption")
+    {}
+};
+
+/*
+ * resume task
+ * Description: closure that resumes a coroutine on an executor,
+ *   a task that is rejected or dropped never resumes user code on the
+ *   posting thread, the coroutine is destroyed and fails its job instead
+ */
+struct ResumeTask
+{
+    explicit ResumeTask(std::coroutine_handle<> handle) : handle(handle) {}
+
+    ResumeTask(ResumeTask&& other) noexcept
+        : handle(std::exchange(other.handle, nullptr))
+    {}
+
+    ResumeTask(const ResumeTask&) = delete;
+    ResumeTask& operator=(const ResumeTask&) = delete;
+    ResumeTask& operator=(ResumeTask&&) = delete;
+
+    ~ResumeTask()
+    {
+        if (handle)
+        {
+            abandon(handle);
+        }
+    }
+
+    void operator()()
+    {
+        std::exchange(handle, nullptr).resume();
+    }
+
+    // post the resumption, the job fails if the executor refuses it
+    static void post(Executor& executor, std::coroutine_handle<> handle)
+    {
+        try
+        {
+            executor.post(ResumeTask(handle));
+        }
+        catch (const std::exception&)
+        {
+            // 被拒绝的 ResumeTask 析构时已放弃该协程, 投递线程可能是定时器
+        }
+    }
+
+    // destroy a suspended coroutine and its callers without resuming them,
+    // the top level task reports ResumeRejected
+    static void abandon(std::coroutine_handle<> handle) noexcept;
+
+    std::coroutine_handle<> handle;
+};
+
+/*
+ * async task
+ * Description: coroutine body of an async job, starts lazily,
+ *   a top level task reports completion through a callback,
+ *   awaiting a nested AsyncTask runs it on the same context
+ */
+class AsyncTask
+{
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(handle_type handle) noexcept
+        {
+            auto& promise = handle.promise();
+            if (promise.continuation)
+            {
+                return promise.continuation;
+            }
+
+            // 先销毁协程帧再通知, 回调中可以安全地回收任务
+            auto done = std::move(promise.done);
+            auto error = promise.error;
+            handle.destroy();
+            if (done)
+            {
+                done(error);
+            }
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type
+    {
+        AsyncTask get_return_object()
+        {
+            return AsyncTask(handle_type::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() noexcept
+        {
+            error = std::current_exception();
+        }
+
+        AsyncContext context;
+        std::coroutine_handle<> continuation;
+        unique_function<void(std::exception_ptr)> done;
+        std::exception_ptr error;
+    };
+
+    // co_await a nested task, its exception is rethrown here
+    struct Awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        handle_type await_suspend(handle_type parent) noexcept
+        {
+            handle.promise().context = parent.promise().context;
+            handle.promise().continuation = parent;
+            return handle;
+        }
+
+        void await_resume() const
+        {
+            if (handle.promise().error)
+            {
+                std::rethrow_exception(handle.promise().error);
+            }
+        }
+
+        handle_type handle;
+    };
+
+    AsyncTask() noexcept = default;
+
+    AsyncTask(AsyncTask&& other) noexcept
+        : handle(std::exchange(other.handle, nullptr))
+    {}
+
+    AsyncTask& operator=(AsyncTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    AsyncTask(const AsyncTask&) = delete;
+    AsyncTask& operator=(const AsyncTask&) = delete;
+
+    ~AsyncTask()
+    {
+        reset();
+    }
+
+    Awaiter operator co_await() && noexcept
+    {
+        return Awaiter{handle};
+    }
+
+    // run until the first suspension, done is called once it finishes,
+    // the coroutine frame then belongs to itself
+    void start(AsyncContext context,
+               unique_function<void(std::exception_ptr)> done) &&
+    {
+        if (!handle)
+        {
+            throw std::runtime_error("AsyncTask is empty");
+        }
+
+        handle.promise().context = context;
+        handle.promise().done = std::move(done);
+        std::exchange(handle, nullptr).resume();
+    }
+
+private:
+    explicit AsyncTask(handle_type handle) : handle(handle) {}
+
+    void reset() noexcept
+    {
+        if (handle)
+        {
+            handle.destroy();
+            handle = nullptr;
+        }
+    }
+
+    handle_type handle;
+};
+
+using AsyncJob = std::function<AsyncTask()>;
+
+inline void ResumeTask::abandon(std::coroutine_handle<> handle) noexcept
+{
+    // 顶层协程帧持有嵌套任务, 销毁它会一并销毁整条调用链
+    auto task = AsyncTask::handle_type::from_address(handle.address());
+    while (task.promise().continuation)
+    {
+        task = AsyncTask::handle_type::from_address(
+            task.promise().continuation.address());
+    }
+
+    auto done = std::move(task.promise().done);
+    task.destroy();
+    if (done)
+    {
+        done(std::make_exception_ptr(ResumeRejected()));
+    }
+}
+
+/*
+ * async timer
+ * Description: one thread sleeping until the earliest deadline,
+ *   due coroutines are posted back to the executor they run on,
+ *   stopping resumes every waiter with an error,
+ *   the thread starts with the first waiter
+ */
+class AsyncTimer
+{
+public:
+    AsyncTimer() = default;
+
+    AsyncTimer(const AsyncTimer&) = delete;
+    AsyncTimer& operator=(const AsyncTimer&) = delete;
+
+    ~AsyncTimer()
+    {
+        stop();
+    }
+
+    // resume handle on executor at deadline, cancelled is set on stop
+    void schedule(std::chrono::steady_clock::time_point deadline,
+                  std::coroutine_handle<> handle, Executor* executor,
+                  bool* cancelled)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stop_flag)
+            {
+                throw std::runtime_error("AsyncTimer stopped");
+            }
+
+            waiters.push(Waiter{deadline, next_seq++, handle, executor,
+                                cancelled});
+            if (!worker.joinable())
+            {
+                worker = std::thread(&AsyncTimer::run, this);
+            }
+        }
+        cv.notify_one();
+    }
+
+    // number of suspended waiters
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return waiters.size();
+    }
+
+    void stop()
+    {
+        std::vector<Waiter> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop_flag = true;
+            for (; !waiters.empty(); waiters.pop())
+            {
+                pending.emplace_back(waiters.top());
+            }
+        }
+        cv.notify_all();
+
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+
+        // 执行器仍然存活, 等待者带着错误恢复并正常结束
+        for (auto& waiter : pending)
+        {
+            *waiter.cancelled = true;
+            ResumeTask::post(*waiter.executor, waiter.handle);
+        }
+    }
+
+private:
+    struct Waiter
+    {
+        std::chrono::steady_clock::time_point deadline;
+        size_t seq;
+        std::coroutine_handle<> handle;
+        Executor* executor;
+        bool* cancelled;
+
+        bool operator>(const Waiter& other) const
+        {
+            return deadline != other.deadline ? deadline > other.deadline
+                                              : seq > other.seq;
+        }
+    };
+
+    void run()
+    {
+        std::vector<Waiter> due;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stop_flag)
+        {
+            if (waiters.empty())
+            {
+                cv.wait(lock);
+                continue;
+            }
+
+            // 等待期间堆可能扩容, 先复制截止时间
+            auto now = std::chrono::steady_clock::now();
+            auto deadline = waiters.top().deadline;
+            if (deadline > now)
+            {
+                cv.wait_until(lock, deadline);
+                continue;
+            }
+
+            for (; !waiters.empty() && waiters.top().deadline <= now;
+                 waiters.pop())
+            {
+                due.emplace_back(waiters.top());
+            }
+
+            // 锁外投递, 执行器阻塞时不影响新的等待者登记
+            lock.unlock();
+            for (auto& waiter : due)
+            {
+                ResumeTask::post(*waiter.executor, waiter.handle);
+            }
+            due.clear();
+            lock.lock();
+        }
+    }
+
+    std::priority_queue<Waiter, std::vector<Waiter>, std::greater<Waiter>>
+        waiters;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread worker;
+    size_t next_seq{0};
+    bool stop_flag{false};
+};
+
+/*
+ * sleep awaiter
+ * Description: suspends an AsyncTask until a deadline without holding
+ *              a worker, throws if the timer stops first
+ */
+struct SleepAwaiter
+{
+    bool await_ready() const noexcept
+    {
+        return deadline <= std::chrono::steady_clock::now();
+    }
+
+    void await_suspend(AsyncTask::handle_type handle)
+    {
+        auto& context = handle.promise().context;
+        context.timer->schedule(deadline, handle, context.executor,
+                                &cancelled);
+    }
+
+    void await_resume() const
+    {
+        if (cancelled)
+        {
+            throw std::runtime_error("AsyncTimer stopped");
+        }
+    }
+
+    std::chrono::steady_clock::time_point deadline;
+    bool cancelled{false};
+};
+
+/*
+ * resume handle
+ * Description: given to the starter of async_resume_when, calling it once
+ *              continues the coroutine on its executor
+ */
+struct AsyncResume
+{
+    void operator()() const
+    {
+        ResumeTask::post(*executor, handle);
+    }
+
+    std::coroutine_handle<> handle;
+    Executor* executor;
+};
+
+template <typename Start>
+struct ResumeWhenAwaiter
+{
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    // 本对象位于协程帧中, start 运行期间协程可能已在其他线程恢复并
+    // 回收该帧, 先移到栈上再调用
+    void await_suspend(AsyncTask::handle_type handle)
+    {
+        Start local = std::move(start);
+        local(AsyncResume{handle, handle.promise().context.executor});
+    }
+
+    void await_resume() const noexcept {}
+
+    Start start;
+};
+
+// suspend for a duration, the worker runs other jobs meanwhile
+template <typename Rep, typename Period>
+SleepAwaiter async_sleep_for(std::chrono::duration<Rep, Period> duration)
+{
+    return SleepAwaiter{std::chrono::steady_clock::now() +
+                        std::chrono::duration_cast<
+                            std::chrono::steady_clock::duration>(duration)};
+}
+
+// suspend until a monotonic deadline
+inline SleepAwaiter
+async_sleep_until(std::chrono::steady_clock::time_point deadline)
+{
+    return SleepAwaiter{deadline};
+}
+
+// suspend until an I/O reactor or callback calls the AsyncResume it is
+// given, start runs on the current worker before the suspension completes
+template <typename Start>
+ResumeWhenAwaiter<std::decay_t<Start>> async_resume_when(Start&& start)
+{
+    return ResumeWhenAwaiter<std::decay_t<Start>>{std::forward<Start>(start)};
+}
+
+#endif
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "chronix/croncpp.h"
+
+/*
+ * cron cache
+ * Description: parsed cron expressions keyed by their text, the least
+ *   recently used entry is evicted past the capacity, so bulk adds and
+ *   persistence loads of repeated schedules parse each one once
+ */
+class CronCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    explicit CronCache(size_t capacity = DEFAULT_CAPACITY)
+        : capacity(capacity)
+    {}
+
+    CronCache(const CronCache&) = delete;
+    CronCache& operator=(const CronCache&) = delete;
+
+    // cache shared by the scheduler and the persistence backends
+    static CronCache& shared()
+    {
+        static CronCache cache;
+        return cache;
+    }
+
+    // parsed expression, throws cron::bad_cronexpr if it is invalid
+    cron::cronexpr get(const std::string& expr)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = index.find(expr);
+            if (it != index.end())
+            {
+                entries.splice(entries.begin(), entries, it->second);
+                hit_count++;
+                return it->second->second;
+            }
+            miss_count++;
+        }
+
+        // 锁外解析, 无效的表达式不缓存
+        auto parsed = cron::make_cron(expr);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (capacity == 0 || index.count(expr) != 0)
+        {
+            return parsed;
+        }
+        entries.emplace_front(expr, parsed);
+        index.emplace(expr, entries.begin());
+        evict();
+        return parsed;
+    }
+
+    // 0 disables caching
+    void set_capacity(size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        capacity = size;
+        evict();
+    }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        index.clear();
+        entries.clear();
+    }
+
+    size_t get_hit_count()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return hit_count;
+    }
+
+    size_t get_miss_count()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return miss_count;
+    }
+
+private:
+    using Entry = std::pair<std::string, cron::cronexpr>;
+
+    // caller holds mutex
+    void evict()
+    {
+        while (entries.size() > capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+    // 表头为最近使用
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    std::mutex mutex;
+    size_t capacity;
+    size_t hit_count{0};
+    size_t miss_count{0};
+};
@@ -8,7 +8,15 @@
 #include <ctime>
 #include <iomanip>
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #if __cplusplus > 201402L
 #include <string_view>
@@ -33,25 +41,23 @@ namespace cron
 
    constexpr size_t INVALID_INDEX = static_cast<size_t>(-1);
 
+   // a seventh, leading field gives the milliseconds of each fire,
+   // six field expressions fire at millisecond 0
+   constexpr unsigned CRON_MAX_MILLISECONDS = 999;
+   constexpr size_t CRON_MILLISECOND_WORDS = 16;
+
    class cronexpr;
 
    namespace detail
    {
-      enum class cron_field
-      {
-         second,
-         minute,
-         hour_of_day,
-         day_of_week,
-         day_of_month,
-         month,
-         year
-      };
+      struct civil_time;
+
+      inline unsigned next_millisecond(cronexpr const & cex, unsigned const offset) noexcept;
 
       template <typename Traits>
-      static bool find_next(cronexpr const & cex,
-                            std::tm& date,
-                            size_t const dot);
+      static bool find_next_civil(cronexpr const & cex,
+                                  civil_time& date,
+                                  int64_t const max_year);
    }
 
    struct bad_cronexpr : public std::runtime_error
@@ -184,13 +190,28 @@ namespace cron
 #endif
    };
 
+   // bit masks of the fields, bit 0 is the minimum of each field
+   struct cron_fields
+   {
+      uint64_t milliseconds[CRON_MILLISECOND_WORDS] = { 1 };
+      uint64_t seconds = 0;
+      uint64_t minutes = 0;
+      uint64_t hours = 0;
+      uint64_t days_of_week = 0;
+      uint64_t days_of_month = 0;
+      uint64_t months = 0;
+   };
+
    class cronexpr;
 
    template <typename Traits = cron_standard_traits>
    static cronexpr make_cron(CRONCPP_STRING_VIEW expr);
 
+   inline cronexpr make_cron(cron_fields const & fields, CRONCPP_STRING_VIEW expr);
+
    class cronexpr
    {
+      std::array<uint64_t, CRON_MILLISECOND_WORDS> milliseconds = {};
       std::bitset<60> seconds;
       std::bitset<60> minutes;
       std::bitset<24> hours;
@@ -203,20 +224,23 @@ namespace cron
       friend bool operator!=(cronexpr const & e1, cronexpr const & e2);
 
       template <typename Traits>
-      friend bool detail::find_next(cronexpr const & cex,
-                                    std::tm& date,
-                                    size_t const dot);
+      friend bool detail::find_next_civil(cronexpr const & cex,
+                                          detail::civil_time& date,
+                                          int64_t const max_year);
+
+      friend unsigned detail::next_millisecond(cronexpr const & cex,
+                                               unsigned const offset) noexcept;
 
       friend std::string to_cronstr(cronexpr const& cex);
       friend std::string to_string(cronexpr const & cex);
 
-      template <typename Traits>
-      friend cronexpr make_cron(CRONCPP_STRING_VIEW expr);
+      friend cronexpr make_cron(cron_fields const & fields, CRONCPP_STRING_VIEW expr);
    };
 
    inline bool operator==(cronexpr const & e1, cronexpr const & e2)
    {
       return
+         e1.milliseconds == e2.milliseconds &&
          e1.seconds == e2.seconds &&
          e1.minutes == e2.minutes &&
          e1.hours == e2.hours &&
@@ -316,7 +340,7 @@ namespace cron
          return text;
       }
 
-      static std::vector<std::string> split(CRONCPP_STRING_VIEW text, char const delimiter)
+      inline std::vector<std::string> split(CRONCPP_STRING_VIEW text, char const delimiter)
       {
          std::vector<std::string> tokens;
          std::string token;
@@ -337,73 +361,181 @@ namespace cron
    namespace detail
    {
 
-      inline cron_int to_cron_int(CRONCPP_STRING_VIEW text)
+      // field names in order, three letters each, the first name stands for
+      // the minimum of its field as in every bundled traits
+      constexpr char const * CRON_DAY_NAMES = "SUNMONTUEWEDTHUFRISAT";
+      constexpr char const * CRON_MONTH_NAMES = "JANFEBMARAPRMAYJUNJULAUGSEPOCTNOVDEC";
+
+      // the parser below works on offsets into the expression, it never
+      // copies a field and can run in a constant expression, each step
+      // returns nullptr or the reason the expression is invalid
+
+      // a number or a case-insensitive name in text[begin, end)
+      CRONCPP_CONSTEXPTR inline char const * parse_cron_value(
+         CRONCPP_STRING_VIEW text,
+         size_t const begin,
+         size_t const end,
+         char const * const names,
+         unsigned const name_count,
+         unsigned const minval,
+         unsigned& value) noexcept
       {
-         try
-         {
-            return static_cast<cron_int>(std::stoul(text.data()));
-         }
-         catch (std::exception const & ex)
+         if (begin == end)
+            return "Missing value in cron expression";
+
+         if (names != nullptr && end - begin == 3)
          {
-            throw bad_cronexpr(ex.what());
+            for (unsigned i = 0; i != name_count; ++i)
+            {
+               bool match = true;
+               for (size_t j = 0; j != 3; ++j)
+               {
+                  char c = text[begin + j];
+                  if (c >= 'a' && c <= 'z')
+                     c = static_cast<char>(c - 'a' + 'A');
+                  match = match && c == names[i * 3 + j];
+               }
+               if (match)
+               {
+                  value = minval + i;
+                  return nullptr;
+               }
+            }
          }
-      }
 
-      static std::string replace_ordinals(
-         std::string text,
-         std::vector<std::string> const & replacement)
-      {
-         for (size_t i = 0; i < replacement.size(); ++i)
+         value = 0;
+         for (size_t i = begin; i != end; ++i)
          {
-            auto pos = text.find(replacement[i]);
-            if (std::string::npos != pos)
-               text.replace(pos, 3 ,std::to_string(i));
+            if (text[i] < '0' || text[i] > '9')
+               return "Invalid number in cron expression";
+            // 超过上限后不再累加, 避免溢出
+            if (value < 1000)
+               value = value * 10 + static_cast<unsigned>(text[i] - '0');
          }
-
-         return text;
+         return nullptr;
       }
 
-      static std::pair<cron_int, cron_int> make_range(
-         CRONCPP_STRING_VIEW field,
-         cron_int const minval,
-         cron_int const maxval)
+      // '*', a single value or first-last
+      CRONCPP_CONSTEXPTR inline char const * parse_cron_range(
+         CRONCPP_STRING_VIEW text,
+         size_t const begin,
+         size_t const end,
+         unsigned const minval,
+         unsigned const maxval,
+         char const * const names,
+         unsigned const name_count,
+         unsigned& first,
+         unsigned& last) noexcept
       {
-         cron_int first = 0;
-         cron_int last = 0;
-         if (field.size() == 1 && field[0] == '*')
+         if (end - begin == 1 && text[begin] == '*')
          {
             first = minval;
             last = maxval;
+            return nullptr;
          }
-         else if (!utils::contains(field, '-'))
+
+         size_t dash = begin;
+         while (dash != end && text[dash] != '-') ++dash;
+
+         char const * error = nullptr;
+         if (dash == end)
          {
-            first = to_cron_int(field);
+            error = parse_cron_value(text, begin, end, names, name_count, minval, first);
             last = first;
          }
          else
          {
-            auto parts = utils::split(field, '-');
-            if (parts.size() != 2)
-               throw bad_cronexpr("Specified range requires two fields");
-
-            first = to_cron_int(parts[0]);
-            last = to_cron_int(parts[1]);
+            size_t other = dash + 1;
+            while (other != end && text[other] != '-') ++other;
+            if (dash == begin || dash + 1 == end || other != end)
+               return "Specified range requires two fields";
+
+            error = parse_cron_value(text, begin, dash, names, name_count, minval, first);
+            if (error == nullptr)
+               error = parse_cron_value(text, dash + 1, end, names, name_count, minval, last);
          }
+         if (error != nullptr)
+            return error;
 
          if (first > maxval || last > maxval)
-         {
-            throw bad_cronexpr("Specified range exceeds maximum");
-         }
+            return "Specified range exceeds maximum";
          if (first < minval || last < minval)
+            return "Specified range is less than minimum";
+         if (first > last)
+            return "Specified range start exceeds range end";
+
+         return nullptr;
+      }
+
+      // comma separated ranges with optional increments, bit 0 of bits[0]
+      // is minval, '?' alone means any value where any_question is set
+      CRONCPP_CONSTEXPTR inline char const * parse_cron_field(
+         CRONCPP_STRING_VIEW text,
+         size_t const begin,
+         size_t const end,
+         unsigned const minval,
+         unsigned const maxval,
+         char const * const names,
+         unsigned const name_count,
+         bool const any_question,
+         uint64_t* const bits) noexcept
+      {
+         for (unsigned word = 0; word <= (maxval - minval) / 64; ++word)
+            bits[word] = 0;
+         if (begin == end)
+            return "Expression parsing error";
+         if (text[end - 1] == ',')
+            return "Value cannot end with comma";
+
+         if (any_question && end - begin == 1 && text[begin] == '?')
          {
-            throw bad_cronexpr("Specified range is less than minimum");
+            for (unsigned i = minval; i <= maxval; ++i)
+               bits[(i - minval) / 64] |= uint64_t{ 1 } << (i - minval) % 64;
+            return nullptr;
          }
-         if (first > last)
+
+         for (size_t item = begin; item < end;)
          {
-            throw bad_cronexpr("Specified range start exceeds range end");
+            size_t item_end = item;
+            while (item_end != end && text[item_end] != ',') ++item_end;
+            size_t slash = item;
+            while (slash != item_end && text[slash] != '/') ++slash;
+
+            unsigned first = 0;
+            unsigned last = 0;
+            char const * error = parse_cron_range(
+               text, item, slash, minval, maxval, names, name_count, first, last);
+            if (error != nullptr)
+               return error;
+
+            unsigned step = 1;
+            if (slash != item_end)
+            {
+               size_t other = slash + 1;
+               while (other != item_end && text[other] != '/') ++other;
+               if (slash + 1 == item_end || other != item_end)
+                  return "Incrementer must have two fields";
+
+               error = parse_cron_value(text, slash + 1, item_end, nullptr, 0, 0, step);
+               if (error != nullptr)
+                  return error;
+               if (step == 0)
+                  return "Incrementer must be a positive value";
+
+               // 单个起点的增量一直延伸到上限
+               size_t dash = item;
+               while (dash != slash && text[dash] != '-') ++dash;
+               if (dash == slash)
+                  last = maxval;
+            }
+
+            for (unsigned i = first; i <= last; i += step)
+               bits[(i - minval) / 64] |= uint64_t{ 1 } << (i - minval) % 64;
+
+            item = item_end + 1;
          }
 
-         return { first, last };
+         return nullptr;
       }
 
       template <size_t N>
@@ -413,505 +545,719 @@ namespace cron
          cron_int const minval,
          cron_int const maxval)
       {
-         if(value.length() > 0 && value[value.length()-1] == ',')
-            throw bad_cronexpr("Value cannot end with comma");
-
-         auto fields = utils::split(value, ',');
-         if (fields.empty())
-            throw bad_cronexpr("Expression parsing error");
+         uint64_t bits = 0;
+         char const * error = parse_cron_field(
+            value, 0, value.size(), minval, maxval, nullptr, 0, false, &bits);
+         if (error != nullptr)
+            throw bad_cronexpr(error);
 
-         for (auto const & field : fields)
-         {
-            if (!utils::contains(field, '/'))
-            {
-#ifdef CRONCPP_IS_CPP17
-               auto[first, last] = detail::make_range(field, minval, maxval);
-#else
-               auto range = detail::make_range(field, minval, maxval);
-               auto first = range.first;
-               auto last = range.second;
-#endif
-               for (cron_int i = first - minval; i <= last - minval; ++i)
-               {
-                  target.set(i);
-               }
-            }
-            else
-            {
-               auto parts = utils::split(field, '/');
-               if (parts.size() != 2)
-                  throw bad_cronexpr("Incrementer must have two fields");
-
-#ifdef CRONCPP_IS_CPP17
-               auto[first, last] = detail::make_range(parts[0], minval, maxval);
-#else
-               auto range = detail::make_range(parts[0], minval, maxval);
-               auto first = range.first;
-               auto last = range.second;
-#endif
+         target |= std::bitset<N>(bits);
+      }
 
-               if (!utils::contains(parts[0], '-'))
-               {
-                  last = maxval;
-               }
+      // broken-down wall clock time, month and day start at 1
+      struct civil_time
+      {
+         int64_t  year;
+         unsigned month;
+         unsigned day;
+         unsigned hour;
+         unsigned minute;
+         unsigned second;
+      };
 
-               auto delta = detail::to_cron_int(parts[1]);
-               if(delta <= 0)
-                  throw bad_cronexpr("Incrementer must be a positive value");
+      // days since 1970-01-01 in the proleptic gregorian calendar
+      CRONCPP_CONSTEXPTR inline int64_t days_from_civil(
+         int64_t year,
+         unsigned const month,
+         unsigned const day) noexcept
+      {
+         year -= month <= 2;
+         int64_t const era = (year >= 0 ? year : year - 399) / 400;
+         unsigned const yoe = static_cast<unsigned>(year - era * 400);
+         unsigned const doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+         unsigned const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+         return era * 146097 + static_cast<int64_t>(doe) - 719468;
+      }
 
-               for (cron_int i = first - minval; i <= last - minval; i += delta)
-               {
-                  target.set(i);
-               }
-            }
-         }
+      CRONCPP_CONSTEXPTR inline civil_time civil_from_days(int64_t days) noexcept
+      {
+         days += 719468;
+         int64_t const era = (days >= 0 ? days : days - 146096) / 146097;
+         unsigned const doe = static_cast<unsigned>(days - era * 146097);
+         unsigned const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+         unsigned const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+         unsigned const mp = (5 * doy + 2) / 153;
+         unsigned const month = mp < 10 ? mp + 3 : mp - 9;
+         return civil_time{
+            static_cast<int64_t>(yoe) + era * 400 + (month <= 2),
+            month,
+            doy - (153 * mp + 2) / 5 + 1,
+            0, 0, 0 };
       }
 
-      template <typename Traits>
-      static void set_cron_days_of_week(
-         std::string value,
-         std::bitset<7>& target)
+      // 0 is Sunday, 1970-01-01 was a Thursday
+      CRONCPP_CONSTEXPTR inline unsigned weekday_from_days(int64_t const days) noexcept
       {
-         auto days = utils::to_upper(value);
-         auto days_replaced = detail::replace_ordinals(
-            days,
-#ifdef CRONCPP_IS_CPP17
-            Traits::DAYS
-#else
-            Traits::DAYS()
-#endif
-         );
+         return static_cast<unsigned>(((days + 4) % 7 + 7) % 7);
+      }
 
-         if (days_replaced.size() == 1 && days_replaced[0] == '?')
-            days_replaced[0] = '*';
+      CRONCPP_CONSTEXPTR inline unsigned days_in_month(
+         int64_t const year,
+         unsigned const month) noexcept
+      {
+         return month != 2 ? 30 + ((month + (month >> 3)) & 1)
+            : (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) ? 29 : 28;
+      }
 
-         set_cron_field(
-            days_replaced,
-            target,
-            Traits::CRON_MIN_DAYS_OF_WEEK,
-            Traits::CRON_MAX_DAYS_OF_WEEK);
+      // seconds since the epoch of a wall clock time, as if it were UTC
+      CRONCPP_CONSTEXPTR inline int64_t civil_to_seconds(civil_time const & date) noexcept
+      {
+         return days_from_civil(date.year, date.month, date.day) * 86400 +
+            date.hour * 3600 + date.minute * 60 + date.second;
       }
 
-      template <typename Traits>
-      static void set_cron_days_of_month(
-         std::string value,
-         std::bitset<31>& target)
+      CRONCPP_CONSTEXPTR inline civil_time civil_from_seconds(int64_t const seconds) noexcept
       {
-         if (value.size() == 1 && value[0] == '?')
-            value[0] = '*';
+         int64_t days = seconds / 86400;
+         int64_t rem = seconds % 86400;
+         if (rem < 0)
+         {
+            rem += 86400;
+            --days;
+         }
 
-         set_cron_field(
-            value,
-            target,
-            Traits::CRON_MIN_DAYS_OF_MONTH,
-            Traits::CRON_MAX_DAYS_OF_MONTH);
+         civil_time date = civil_from_days(days);
+         date.hour = static_cast<unsigned>(rem / 3600);
+         date.minute = static_cast<unsigned>(rem / 60 % 60);
+         date.second = static_cast<unsigned>(rem % 60);
+         return date;
       }
 
-      template <typename Traits>
-      static void set_cron_month(
-         std::string value,
-         std::bitset<12>& target)
+      inline unsigned count_trailing_zeros(uint64_t const bits) noexcept
       {
-         auto month = utils::to_upper(value);
-         auto month_replaced = replace_ordinals(
-            month,
-#ifdef CRONCPP_IS_CPP17
-            Traits::MONTHS
+#if defined(_MSC_VER)
+         unsigned long index = 0;
+         _BitScanForward64(&index, bits);
+         return static_cast<unsigned>(index);
 #else
-            Traits::MONTHS()
+         return static_cast<unsigned>(__builtin_ctzll(bits));
 #endif
-         );
-
-         set_cron_field(
-            month_replaced,
-            target,
-            Traits::CRON_MIN_MONTHS,
-            Traits::CRON_MAX_MONTHS);
       }
 
-      template <size_t N>
-      inline size_t next_set_bit(
-         std::bitset<N> const & target,
-         size_t /*minimum*/,
-         size_t /*maximum*/,
-         size_t offset)
+      // lowest set bit at or above offset, 64 if there is none
+      inline unsigned next_bit(uint64_t const bits, unsigned const offset) noexcept
       {
-         for (auto i = offset; i < N; ++i)
-         {
-            if (target.test(i)) return i;
-         }
+         if (offset >= 64) return 64;
 
-         return INVALID_INDEX;
+         uint64_t const rest = bits >> offset << offset;
+         return rest == 0 ? 64 : count_trailing_zeros(rest);
       }
 
-      inline void add_to_field(
-         std::tm& date,
-         cron_field const field,
-         int const val)
+      // lowest millisecond of the field at or above offset, 1000 if none
+      inline unsigned next_millisecond(cronexpr const & cex, unsigned const offset) noexcept
       {
-         switch (field)
+         for (unsigned word = offset / 64; word < CRON_MILLISECOND_WORDS; ++word)
          {
-         case cron_field::second:
-            date.tm_sec += val;
-            break;
-         case cron_field::minute:
-            date.tm_min += val;
-            break;
-         case cron_field::hour_of_day:
-            date.tm_hour += val;
-            break;
-         case cron_field::day_of_week:
-         case cron_field::day_of_month:
-            date.tm_mday += val;
-            date.tm_isdst = -1;
-            break;
-         case cron_field::month:
-            date.tm_mon += val;
-            date.tm_isdst = -1;
-            break;
-         case cron_field::year:
-            date.tm_year += val;
-            break;
+            unsigned const bit = next_bit(cex.milliseconds[word], word == offset / 64 ? offset % 64 : 0);
+            if (bit != 64)
+               return word * 64 + bit;
          }
+         return CRON_MAX_MILLISECONDS + 1;
+      }
 
-         if (INVALID_TIME == utils::tm_to_time(date))
-            throw bad_cronexpr("Invalid time expression");
+      // milliseconds since the epoch, rounded down
+      inline int64_t to_milliseconds(std::chrono::system_clock::time_point const & time_point)
+      {
+         auto const since = time_point.time_since_epoch();
+         auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(since);
+         if (millis > since)
+            millis -= std::chrono::milliseconds(1);
+         return static_cast<int64_t>(millis.count());
       }
 
-      inline void set_field(
-         std::tm& date,
-         cron_field const field,
-         int const val)
+      inline std::chrono::system_clock::time_point from_milliseconds(int64_t const millis)
       {
-         switch (field)
-         {
-         case cron_field::second:
-            date.tm_sec = val;
-            break;
-         case cron_field::minute:
-            date.tm_min = val;
-            break;
-         case cron_field::hour_of_day:
-            date.tm_hour = val;
-            break;
-         case cron_field::day_of_week:
-            date.tm_wday = val;
-            break;
-         case cron_field::day_of_month:
-            date.tm_mday = val;
-            date.tm_isdst = -1;
-            break;
-         case cron_field::month:
-            date.tm_mon = val;
-            date.tm_isdst = -1;
-            break;
-         case cron_field::year:
-            date.tm_year = val;
-            break;
-         }
+         return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+               std::chrono::milliseconds(millis)));
+      }
 
-         if (INVALID_TIME == utils::tm_to_time(date))
-            throw bad_cronexpr("Invalid time expression");
+      // days of a month whose weekday is allowed, bit 0 is the 1st
+      inline uint64_t weekday_mask(
+         uint64_t const days_of_week,
+         unsigned const first_weekday) noexcept
+      {
+         // 按月初星期几旋转, 再以 7 天为周期铺满 31 天
+         uint64_t const week =
+            ((days_of_week >> first_weekday) | (days_of_week << (7 - first_weekday))) & 0x7F;
+         return week | week << 7 | week << 14 | week << 21 | week << 28;
       }
 
-      inline void reset_field(
-         std::tm& date,
-         cron_field const field)
+      // earliest time at or after date that matches, every field jumps
+      // straight to its next set bit and carries into the one above
+      template <typename Traits>
+      static bool find_next_civil(cronexpr const & cex,
+                                  civil_time& date,
+                                  int64_t const max_year)
       {
-         switch (field)
+         uint64_t const seconds = cex.seconds.to_ullong();
+         uint64_t const minutes = cex.minutes.to_ullong();
+         uint64_t const hours = cex.hours.to_ullong();
+         uint64_t const days_of_month = cex.days_of_month.to_ullong();
+         // 各 traits 下 bit 0 都是星期日
+         uint64_t const days_of_week = cex.days_of_week.to_ullong();
+         uint64_t const months = cex.months.to_ullong();
+
+         while (date.year <= max_year)
          {
-         case cron_field::second:
-            date.tm_sec = 0;
-            break;
-         case cron_field::minute:
-            date.tm_min = 0;
-            break;
-         case cron_field::hour_of_day:
-            date.tm_hour = 0;
-            break;
-         case cron_field::day_of_week:
-            date.tm_wday = 0;
-            break;
-         case cron_field::day_of_month:
-            date.tm_mday = 1;
-            date.tm_isdst = -1;
-            break;
-         case cron_field::month:
-            date.tm_mon = 0;
-            date.tm_isdst = -1;
-            break;
-         case cron_field::year:
-            date.tm_year = 0;
-            break;
+            unsigned const month = next_bit(months, date.month - 1);
+            if (month == 64)
+            {
+               ++date.year;
+               date.month = 1;
+               date.day = 1;
+               date.hour = date.minute = date.second = 0;
+               continue;
+            }
+            if (month != date.month - 1)
+            {
+               date.month = month + 1;
+               date.day = 1;
+               date.hour = date.minute = date.second = 0;
+            }
+
+            int64_t const first = days_from_civil(date.year, date.month, 1);
+            uint64_t const allowed = days_of_month &
+               weekday_mask(days_of_week, weekday_from_days(first)) &
+               ((uint64_t{ 1 } << days_in_month(date.year, date.month)) - 1);
+            unsigned const day = next_bit(allowed, date.day - 1);
+            if (day == 64)
+            {
+               if (++date.month > 12)
+               {
+                  ++date.year;
+                  date.month = 1;
+               }
+               date.day = 1;
+               date.hour = date.minute = date.second = 0;
+               continue;
+            }
+            if (day != date.day - 1)
+            {
+               date.day = day + 1;
+               date.hour = date.minute = date.second = 0;
+            }
+
+            unsigned const hour = next_bit(hours, date.hour);
+            if (hour == 64)
+            {
+               ++date.day;
+               date.hour = date.minute = date.second = 0;
+               continue;
+            }
+            if (hour != date.hour)
+            {
+               date.hour = hour;
+               date.minute = date.second = 0;
+            }
+
+            unsigned const minute = next_bit(minutes, date.minute);
+            if (minute == 64)
+            {
+               ++date.hour;
+               date.minute = date.second = 0;
+               continue;
+            }
+            if (minute != date.minute)
+            {
+               date.minute = minute;
+               date.second = 0;
+            }
+
+            unsigned const second = next_bit(seconds, date.second);
+            if (second == 64)
+            {
+               ++date.minute;
+               date.second = 0;
+               continue;
+            }
+
+            date.second = second;
+            return true;
          }
 
-         if (INVALID_TIME == utils::tm_to_time(date))
-            throw bad_cronexpr("Invalid time expression");
+         return false;
       }
+   }
 
-      inline void reset_all_fields(
-         std::tm& date,
-         std::bitset<7> const & marked_fields)
+   // parse without allocating, usable in a constant expression, returns
+   // nullptr or the reason the expression is invalid
+   template <typename Traits = cron_standard_traits>
+   static CRONCPP_CONSTEXPTR char const * parse_cron(CRONCPP_STRING_VIEW expr, cron_fields& fields) noexcept
+   {
+      if (expr.empty())
+         return "Invalid empty cron expression";
+
+      size_t begins[7] = {};
+      size_t ends[7] = {};
+      size_t count = 0;
+      for (size_t i = 0; i < expr.size();)
       {
-         for (size_t i = 0; i < marked_fields.size(); ++i)
+         if (expr[i] == ' ')
          {
-            if (marked_fields.test(i))
-               reset_field(date, static_cast<cron_field>(i));
+            ++i;
+            continue;
          }
+         if (count == 7)
+            return "cron expression must have six or seven fields";
+
+         begins[count] = i;
+         while (i < expr.size() && expr[i] != ' ') ++i;
+         ends[count++] = i;
       }
+      if (count < 6)
+         return "cron expression must have six or seven fields";
 
-      inline void mark_field(
-         std::bitset<7> & orders,
-         cron_field const field)
+      // 七个字段时第一个是毫秒, 其余字段依次后移
+      size_t const first = count - 6;
+      char const * error = nullptr;
+      if (first == 0)
       {
-         if (!orders.test(static_cast<size_t>(field)))
-            orders.set(static_cast<size_t>(field));
+         fields.milliseconds[0] = 1;
+         for (size_t word = 1; word != CRON_MILLISECOND_WORDS; ++word)
+            fields.milliseconds[word] = 0;
       }
+      else
+      {
+         error = detail::parse_cron_field(
+            expr, begins[0], ends[0], 0, CRON_MAX_MILLISECONDS,
+            nullptr, 0, false, fields.milliseconds);
+      }
+      if (error == nullptr)
+         error = detail::parse_cron_field(
+            expr, begins[first], ends[first], Traits::CRON_MIN_SECONDS, Traits::CRON_MAX_SECONDS,
+            nullptr, 0, false, &fields.seconds);
+      if (error == nullptr)
+         error = detail::parse_cron_field(
+            expr, begins[first + 1], ends[first + 1], Traits::CRON_MIN_MINUTES, Traits::CRON_MAX_MINUTES,
+            nullptr, 0, false, &fields.minutes);
+      if (error == nullptr)
+         error = detail::parse_cron_field(
+            expr, begins[first + 2], ends[first + 2], Traits::CRON_MIN_HOURS, Traits::CRON_MAX_HOURS,
+            nullptr, 0, false, &fields.hours);
+      if (error == nullptr)
+         error = detail::parse_cron_field(
+            expr, begins[first + 3], ends[first + 3], Traits::CRON_MIN_DAYS_OF_MONTH, Traits::CRON_MAX_DAYS_OF_MONTH,
+            nullptr, 0, true, &fields.days_of_month);
+      if (error == nullptr)
+         error = detail::parse_cron_field(
+            expr, begins[first + 4], ends[first + 4], Traits::CRON_MIN_MONTHS, Traits::CRON_MAX_MONTHS,
+            detail::CRON_MONTH_NAMES, 12, false, &fields.months);
+      if (error == nullptr)
+         error = detail::parse_cron_field(
+            expr, begins[first + 5], ends[first + 5], Traits::CRON_MIN_DAYS_OF_WEEK, Traits::CRON_MAX_DAYS_OF_WEEK,
+            detail::CRON_DAY_NAMES, 7, true, &fields.days_of_week);
+
+      return error;
+   }
 
-      template <size_t N>
-      static size_t find_next(
-         std::bitset<N> const & target,
-         std::tm& date,
-         unsigned int const minimum,
-         unsigned int const maximum,
-         unsigned int const value,
-         cron_field const field,
-         cron_field const next_field,
-         std::bitset<7> const & marked_fields)
-      {
-         auto next_value = next_set_bit(target, minimum, maximum, value);
-         if (INVALID_INDEX == next_value)
-         {
-            add_to_field(date, next_field, 1);
-            reset_field(date, field);
-            next_value = next_set_bit(target, minimum, maximum, 0);
-         }
+   // static_assert(cron::is_valid_cron("0 */5 * * * *")) checks a literal
+   // while compiling
+   template <typename Traits = cron_standard_traits>
+   static CRONCPP_CONSTEXPTR bool is_valid_cron(CRONCPP_STRING_VIEW expr) noexcept
+   {
+      cron_fields fields;
+      return parse_cron<Traits>(expr, fields) == nullptr;
+   }
 
-         if (INVALID_INDEX == next_value || next_value != value)
-         {
-            set_field(date, field, static_cast<int>(next_value));
-            reset_all_fields(date, marked_fields);
-         }
+   inline cronexpr make_cron(cron_fields const & fields, CRONCPP_STRING_VIEW expr)
+   {
+      cronexpr cex;
+      std::copy(std::begin(fields.milliseconds), std::end(fields.milliseconds),
+                cex.milliseconds.begin());
+      cex.seconds = std::bitset<60>(fields.seconds);
+      cex.minutes = std::bitset<60>(fields.minutes);
+      cex.hours = std::bitset<24>(fields.hours);
+      cex.days_of_week = std::bitset<7>(fields.days_of_week);
+      cex.days_of_month = std::bitset<31>(fields.days_of_month);
+      cex.months = std::bitset<12>(fields.months);
+      cex.expr = std::string(expr);
 
-         return next_value;
+      return cex;
+   }
+
+   template <typename Traits>
+   static cronexpr make_cron(CRONCPP_STRING_VIEW expr)
+   {
+      cron_fields fields;
+      char const * error = parse_cron<Traits>(expr, fields);
+      if (error != nullptr)
+         throw bad_cronexpr(error);
+
+      return make_cron(fields, expr);
+   }
+
+#if __cplusplus >= 202002L
+   // an expression parsed while compiling, an invalid literal is a build
+   // error: cron::cron_literal expr = "0 */5 * * * *";
+   template <typename Traits = cron_standard_traits>
+   struct cron_literal
+   {
+      consteval cron_literal(char const * literal) : text(literal)
+      {
+         if (parse_cron<Traits>(text, fields) != nullptr)
+            throw bad_cronexpr("Invalid cron literal");
       }
 
-      template <typename Traits>
-      static size_t find_next_day(
-         std::tm& date,
-         std::bitset<31> const & days_of_month,
-         size_t day_of_month,
-         std::bitset<7> const & days_of_week,
-         size_t day_of_week,
-         std::bitset<7> const & marked_fields)
-      {
-         unsigned int count = 0;
-         unsigned int maximum = 366;
-         while (
-            (!days_of_month.test(day_of_month - Traits::CRON_MIN_DAYS_OF_MONTH) ||
-            !days_of_week.test(day_of_week - Traits::CRON_MIN_DAYS_OF_WEEK))
-            && count++ < maximum)
-         {
-            add_to_field(date, cron_field::day_of_month, 1);
+      cronexpr to_cronexpr() const
+      {
+         return make_cron(fields, text);
+      }
 
-            day_of_month = date.tm_mday;
-            day_of_week = date.tm_wday;
+      std::string_view text;
+      cron_fields fields;
+   };
+#endif
 
-            reset_all_fields(date, marked_fields);
-         }
+   // closed form, local time is converted once on the way in and once out,
+   // the time_t and std::tm overloads work in whole seconds and ignore the
+   // millisecond field
+   template <typename Traits = cron_standard_traits>
+   static std::time_t cron_next(cronexpr const & cex, std::time_t const & date)
+   {
+      std::tm val;
+      std::tm* dt = utils::time_to_tm(&date, &val);
+      if (dt == nullptr) return INVALID_TIME;
+
+      detail::civil_time next{
+         dt->tm_year + 1900,
+         static_cast<unsigned>(dt->tm_mon + 1),
+         static_cast<unsigned>(dt->tm_mday),
+         static_cast<unsigned>(dt->tm_hour),
+         static_cast<unsigned>(dt->tm_min),
+         static_cast<unsigned>(dt->tm_sec) + 1 };
+      if (!detail::find_next_civil<Traits>(cex, next, next.year + Traits::CRON_MAX_YEARS_DIFF))
+         return INVALID_TIME;
 
-         return day_of_month;
+      val = {};
+      val.tm_year = static_cast<int>(next.year - 1900);
+      val.tm_mon = static_cast<int>(next.month - 1);
+      val.tm_mday = static_cast<int>(next.day);
+      val.tm_hour = static_cast<int>(next.hour);
+      val.tm_min = static_cast<int>(next.minute);
+      val.tm_sec = static_cast<int>(next.second);
+      val.tm_isdst = -1;
+      std::tm const wall = val;
+
+      time_t calculated = utils::tm_to_time(val);
+      if (INVALID_TIME != calculated && calculated <= date)
+      {
+         // 夏令时回拨的重复时段取较晚的一次
+         val = wall;
+         val.tm_isdst = 0;
+         calculated = utils::tm_to_time(val);
       }
 
-      template <typename Traits>
-      static bool find_next(cronexpr const & cex,
-                            std::tm& date,
-                            size_t const dot)
-      {
-         bool res = true;
-
-         std::bitset<7> marked_fields{ 0 };
-         std::bitset<7> empty_list{ 0 };
-
-         unsigned int second = date.tm_sec;
-         auto updated_second = find_next(
-            cex.seconds,
-            date,
-            Traits::CRON_MIN_SECONDS,
-            Traits::CRON_MAX_SECONDS,
-            second,
-            cron_field::second,
-            cron_field::minute,
-            empty_list);
-
-         if (second == updated_second)
-         {
-            mark_field(marked_fields, cron_field::second);
-         }
+      return calculated;
+   }
 
-         unsigned int minute = date.tm_min;
-         auto update_minute = find_next(
-            cex.minutes,
-            date,
-            Traits::CRON_MIN_MINUTES,
-            Traits::CRON_MAX_MINUTES,
-            minute,
-            cron_field::minute,
-            cron_field::hour_of_day,
-            marked_fields);
-         if (minute == update_minute)
-         {
-            mark_field(marked_fields, cron_field::minute);
-         }
-         else
-         {
-            res = find_next<Traits>(cex, date, dot);
-            if (!res) return res;
-         }
+   // std::tm in local time through the time_t overload, so both agree on
+   // daylight saving time, a zeroed std::tm if there is no next fire
+   template <typename Traits = cron_standard_traits>
+   static std::tm cron_next(cronexpr const & cex, std::tm date)
+   {
+      time_t original = utils::tm_to_time(date);
+      if (INVALID_TIME == original) return {};
 
-         unsigned int hour = date.tm_hour;
-         auto updated_hour = find_next(
-            cex.hours,
-            date,
-            Traits::CRON_MIN_HOURS,
-            Traits::CRON_MAX_HOURS,
-            hour,
-            cron_field::hour_of_day,
-            cron_field::day_of_week,
-            marked_fields);
-         if (hour == updated_hour)
-         {
-            mark_field(marked_fields, cron_field::hour_of_day);
-         }
-         else
+      time_t calculated = cron_next<Traits>(cex, original);
+      if (INVALID_TIME == calculated) return {};
+
+      std::tm next;
+      if (utils::time_to_tm(&calculated, &next) == nullptr) return {};
+
+      return next;
+   }
+
+   // zone converts between seconds since the epoch and wall clock seconds
+   // through to_local(int64_t) and to_utc(int64_t local, bool later),
+   // no libc time function is called
+   template <typename Traits = cron_standard_traits, typename Zone>
+   static std::time_t cron_next(cronexpr const & cex, std::time_t const & date, Zone const & zone)
+   {
+      auto next = detail::civil_from_seconds(zone.to_local(date) + 1);
+      if (!detail::find_next_civil<Traits>(cex, next, next.year + Traits::CRON_MAX_YEARS_DIFF))
+         return INVALID_TIME;
+
+      int64_t const local = detail::civil_to_seconds(next);
+      int64_t calculated = zone.to_utc(local, false);
+      if (calculated <= date)
+         calculated = zone.to_utc(local, true);
+
+      return static_cast<std::time_t>(calculated);
+   }
+
+   namespace detail
+   {
+      // the process zone through localtime and mktime, for the overloads
+      // that take no zone
+      struct system_zone
+      {
+         int64_t to_local(int64_t const utc) const
          {
-            res = find_next<Traits>(cex, date, dot);
-            if (!res) return res;
+            std::time_t const date = static_cast<std::time_t>(utc);
+            std::tm val;
+            std::tm* dt = utils::time_to_tm(&date, &val);
+            if (dt == nullptr) return utc;
+
+            return days_from_civil(dt->tm_year + 1900,
+                                   static_cast<unsigned>(dt->tm_mon + 1),
+                                   static_cast<unsigned>(dt->tm_mday)) * 86400 +
+               dt->tm_hour * 3600 + dt->tm_min * 60 + dt->tm_sec;
          }
 
-         unsigned int day_of_week = date.tm_wday;
-         unsigned int day_of_month = date.tm_mday;
-         auto updated_day_of_month = find_next_day<Traits>(
-            date,
-            cex.days_of_month,
-            day_of_month,
-            cex.days_of_week,
-            day_of_week,
-            marked_fields);
-         if (day_of_month == updated_day_of_month)
+         int64_t to_utc(int64_t const local, bool const later) const
          {
-            mark_field(marked_fields, cron_field::day_of_month);
+            civil_time const date = civil_from_seconds(local);
+            std::tm val = {};
+            val.tm_year = static_cast<int>(date.year - 1900);
+            val.tm_mon = static_cast<int>(date.month - 1);
+            val.tm_mday = static_cast<int>(date.day);
+            val.tm_hour = static_cast<int>(date.hour);
+            val.tm_min = static_cast<int>(date.minute);
+            val.tm_sec = static_cast<int>(date.second);
+            val.tm_isdst = later ? 0 : -1;
+            return utils::tm_to_time(val);
          }
-         else
+      };
+
+      inline system_zone const & process_zone()
+      {
+         static system_zone const zone;
+         return zone;
+      }
+
+      // successive fire times of one expression in milliseconds, the wall
+      // clock time of the last fire is kept so each step resumes the
+      // calendar walk where the previous one ended instead of rebuilding it
+      // from seconds
+      template <typename Traits, typename Zone>
+      class fire_cursor
+      {
+      public:
+         fire_cursor() = default;
+
+         // fires come strictly after from, in milliseconds since the epoch
+         fire_cursor(cronexpr const & cex, int64_t const from, Zone const & zone)
+            : cex(&cex), zone(&zone)
          {
-            res = find_next<Traits>(cex, date, dot);
-            if (!res) return res;
+            start_second = from / 1000 - (from % 1000 < 0);
+            start_millisecond = static_cast<int>(from - start_second * 1000);
+            last = start_second - 1;
+            // 从起点所在的秒开始, 回拨时段内的起点仍按其实际墙上时间继续
+            date = civil_from_seconds(zone.to_local(start_second));
+            done = next_millisecond(cex, 0) > CRON_MAX_MILLISECONDS;
          }
 
-         unsigned int month = date.tm_mon;
-         auto updated_month = find_next(
-            cex.months,
-            date,
-            Traits::CRON_MIN_MONTHS,
-            Traits::CRON_MAX_MONTHS,
-            month,
-            cron_field::month,
-            cron_field::year,
-            marked_fields);
-         if (month != updated_month)
+         // advance to the next fire, false once there is none
+         bool next(int64_t& fire)
          {
-            if (date.tm_year - dot > Traits::CRON_MAX_YEARS_DIFF)
-               return false;
-
-            res = find_next<Traits>(cex, date, dot);
-            if (!res) return res;
-         }
+            while (!done)
+            {
+               if (in_second)
+               {
+                  unsigned const ms = next_millisecond(*cex, static_cast<unsigned>(millisecond + 1));
+                  if (ms <= CRON_MAX_MILLISECONDS)
+                  {
+                     millisecond = static_cast<int>(ms);
+                     fire = second * 1000 + millisecond;
+                     return true;
+                  }
+               }
 
-         return res;
-      }
-   }
+               if (!next_second(second))
+               {
+                  done = true;
+                  break;
+               }
+               // 起点所在的秒只取起点之后的毫秒
+               millisecond = second == start_second ? start_millisecond : -1;
+               in_second = true;
+            }
 
-   template <typename Traits>
-   static cronexpr make_cron(CRONCPP_STRING_VIEW expr)
-   {
-      cronexpr cex;
+            return false;
+         }
 
-      if (expr.empty())
-         throw bad_cronexpr("Invalid empty cron expression");
+      private:
+         bool next_second(int64_t& fire)
+         {
+            for (int attempt = 0; attempt != 2; ++attempt)
+            {
+               if (!find_next_civil<Traits>(*cex, date, date.year + Traits::CRON_MAX_YEARS_DIFF))
+                  return false;
 
-      auto fields = utils::split(expr, ' ');
-      fields.erase(
-         std::remove_if(std::begin(fields), std::end(fields),
-            [](CRONCPP_STRING_VIEW s) {return s.empty(); }),
-         std::end(fields));
-      if (fields.size() != 6)
-         throw bad_cronexpr("cron expression must have six fields");
+               int64_t const local = civil_to_seconds(date);
+               int64_t calculated = zone->to_utc(local, false);
+               if (calculated <= last)
+                  calculated = zone->to_utc(local, true);
 
-      detail::set_cron_field(fields[0], cex.seconds, Traits::CRON_MIN_SECONDS, Traits::CRON_MAX_SECONDS);
-      detail::set_cron_field(fields[1], cex.minutes, Traits::CRON_MIN_MINUTES, Traits::CRON_MAX_MINUTES);
-      detail::set_cron_field(fields[2], cex.hours, Traits::CRON_MIN_HOURS, Traits::CRON_MAX_HOURS);
+               if (calculated > last)
+               {
+                  last = calculated;
+                  fire = calculated;
+                  // 落在夏令时缺口的时间被顺延, 与 cron_next 一样从实际触发时刻的墙上时间继续
+                  int64_t const wall = zone->to_local(calculated);
+                  if (wall == local)
+                     ++date.second;
+                  else
+                     date = civil_from_seconds(wall + 1);
+                  return true;
+               }
 
-      detail::set_cron_days_of_week<Traits>(fields[5], cex.days_of_week);
+               date = civil_from_seconds(zone->to_local(last) + 1);
+            }
 
-      detail::set_cron_days_of_month<Traits>(fields[3], cex.days_of_month);
+            return false;
+         }
 
-      detail::set_cron_month<Traits>(fields[4], cex.months);
+         cronexpr const * cex = nullptr;
+         Zone const * zone = nullptr;
+         int64_t start_second = 0;
+         int start_millisecond = 0;
+         int64_t last = 0;
+         civil_time date = {};
+         int64_t second = 0;
+         int millisecond = -1;
+         bool in_second = false;
+         bool done = true;
+      };
+   }
 
-      cex.expr = expr;
+   // millisecond precise, a six field expression fires on whole seconds
+   template <typename Traits = cron_standard_traits, typename Zone>
+   static std::chrono::system_clock::time_point cron_next(cronexpr const & cex, std::chrono::system_clock::time_point const & time_point, Zone const & zone)
+   {
+      detail::fire_cursor<Traits, Zone> cursor(cex, detail::to_milliseconds(time_point), zone);
+      int64_t fire = 0;
+      if (!cursor.next(fire))
+         return std::chrono::system_clock::from_time_t(INVALID_TIME);
 
-      return cex;
+      return detail::from_milliseconds(fire);
    }
 
    template <typename Traits = cron_standard_traits>
-   static std::tm cron_next(cronexpr const & cex, std::tm date)
+   static std::chrono::system_clock::time_point cron_next(cronexpr const & cex, std::chrono::system_clock::time_point const & time_point)
    {
-      time_t original = utils::tm_to_time(date);
-      if (INVALID_TIME == original) return {};
-
-      if (!detail::find_next<Traits>(cex, date, date.tm_year))
-         return {};
-
-      time_t calculated = utils::tm_to_time(date);
-      if (INVALID_TIME == calculated) return {};
+      return cron_next<Traits>(cex, time_point, detail::process_zone());
+   }
 
-      if (calculated == original)
+   // the next n fire times after from, the same as n chained calls to
+   // cron_next but the calendar is walked once, returns the end of out
+   template <typename Traits = cron_standard_traits, typename OutputIt, typename Zone>
+   static OutputIt cron_next_n(cronexpr const & cex, std::chrono::system_clock::time_point const & from, size_t n, OutputIt out, Zone const & zone)
+   {
+      detail::fire_cursor<Traits, Zone> cursor(cex, detail::to_milliseconds(from), zone);
+      int64_t fire = 0;
+      for (; n != 0 && cursor.next(fire); --n)
       {
-         add_to_field(date, detail::cron_field::second, 1);
-         if (!detail::find_next<Traits>(cex, date, date.tm_year))
-            return {};
+         *out++ = detail::from_milliseconds(fire);
       }
+      return out;
+   }
 
-      return date;
+   template <typename Traits = cron_standard_traits, typename OutputIt>
+   static OutputIt cron_next_n(cronexpr const & cex, std::chrono::system_clock::time_point const & from, size_t n, OutputIt out)
+   {
+      return cron_next_n<Traits>(cex, from, n, out, detail::process_zone());
    }
 
-   template <typename Traits = cron_standard_traits>
-   static std::time_t cron_next(cronexpr const & cex, std::time_t const & date)
+   // fire times in (from, to], iterated lazily, the expression and the zone
+   // must outlive the range
+   template <typename Traits = cron_standard_traits, typename Zone = detail::system_zone>
+   class cron_range
    {
-      std::tm val;
-      std::tm* dt = utils::time_to_tm(&date, &val);
-      if (dt == nullptr) return INVALID_TIME;
+   public:
+      class iterator
+      {
+      public:
+         using iterator_category = std::input_iterator_tag;
+         using value_type = std::chrono::system_clock::time_point;
+         using difference_type = std::ptrdiff_t;
+         using pointer = value_type const *;
+         using reference = value_type const &;
 
-      time_t original = utils::tm_to_time(*dt);
-      if (INVALID_TIME == original) return INVALID_TIME;
+         iterator() = default;
 
-      if(!detail::find_next<Traits>(cex, *dt, dt->tm_year))
-         return INVALID_TIME;
+         reference operator*() const { return current; }
+         pointer operator->() const { return &current; }
 
-      time_t calculated = utils::tm_to_time(*dt);
-      if (INVALID_TIME == calculated) return calculated;
+         iterator& operator++()
+         {
+            advance();
+            return *this;
+         }
 
-      if (calculated == original)
-      {
-         add_to_field(*dt, detail::cron_field::second, 1);
-         if(!detail::find_next<Traits>(cex, *dt, dt->tm_year))
-            return INVALID_TIME;
-      }
+         iterator operator++(int)
+         {
+            iterator old = *this;
+            advance();
+            return old;
+         }
+
+         // only the end position compares equal to another iterator
+         bool operator==(iterator const & other) const { return done && other.done; }
+         bool operator!=(iterator const & other) const { return !(*this == other); }
+
+      private:
+         friend class cron_range;
+
+         iterator(detail::fire_cursor<Traits, Zone> const & cursor, int64_t const to)
+            : cursor(cursor), to(to), done(false)
+         {
+            advance();
+         }
 
-      return utils::tm_to_time(*dt);
+         void advance()
+         {
+            int64_t fire = 0;
+            if (!cursor.next(fire) || fire > to)
+            {
+               done = true;
+               return;
+            }
+            current = detail::from_milliseconds(fire);
+         }
+
+         detail::fire_cursor<Traits, Zone> cursor;
+         int64_t to = 0;
+         bool done = true;
+         value_type current;
+      };
+
+      cron_range(cronexpr const & cex,
+                 std::chrono::system_clock::time_point const & from,
+                 std::chrono::system_clock::time_point const & to,
+                 Zone const & zone)
+         : cursor(cex, detail::to_milliseconds(from), zone),
+           to(detail::to_milliseconds(to))
+      {}
+
+      iterator begin() const { return iterator(cursor, to); }
+      iterator end() const { return iterator(); }
+
+   private:
+      detail::fire_cursor<Traits, Zone> cursor;
+      int64_t to;
+   };
+
+   template <typename Traits = cron_standard_traits, typename Zone>
+   static cron_range<Traits, Zone> cron_between(cronexpr const & cex, std::chrono::system_clock::time_point const & from, std::chrono::system_clock::time_point const & to, Zone const & zone)
+   {
+      return cron_range<Traits, Zone>(cex, from, to, zone);
    }
 
-  template <typename Traits = cron_standard_traits>
-  static std::chrono::system_clock::time_point cron_next(cronexpr const & cex, std::chrono::system_clock::time_point const & time_point) {
-     return std::chrono::system_clock::from_time_t(cron_next<Traits>(cex, std::chrono::system_clock::to_time_t(time_point)));
-  }
+   template <typename Traits = cron_standard_traits>
+   static cron_range<Traits> cron_between(cronexpr const & cex, std::chrono::system_clock::time_point const & from, std::chrono::system_clock::time_point const & to)
+   {
+      return cron_range<Traits>(cex, from, to, detail::process_zone());
+   }
 }
@@ -1,15 +1,25 @@
 #pragma once
 
+#include <exception>
 #include <functional>
+#include <memory>
 
 #include "chronix/croncpp.h"
+#include "chronix/time_zone.h"
+#include "chronix/thread_pool/unique_function.h"
 
 using Task = std::function<void()>;
 
-using StartCallback = std::function<void(int job_id)>;
-using EndCallback = std::function<void(int job_id)>;
-using ErrorCallback = std::function<void(int job_id, const std::exception& e)>;
-using SuccessCallback = std::function<void(int job_id)>;
+// starts an async job on the executor of a pool, done is called once when
+// it finishes, with the exception it failed with if any
+using AsyncStart = std::function<void(
+    size_t pool, unique_function<void(std::exception_ptr error)> done)>;
+
+using StartCallback = std::function<void(size_t job_id)>;
+using EndCallback = std::function<void(size_t job_id)>;
+using ErrorCallback =
+    std::function<void(size_t job_id, const std::exception& e)>;
+using SuccessCallback = std::function<void(size_t job_id)>;
 
 enum class JobStatus
 {
@@ -32,11 +42,28 @@ enum class JobType
     Immediate
 };
 
+// what a cron job does with fires missed by more than the misfire threshold
+enum class MisfirePolicy
+{
+    FireOnce,
+    FireAll,
+    Skip
+};
+
+// executor lane a job is queued in, higher lanes are served first
+enum class JobPriority
+{
+    Low,
+    Normal,
+    High
+};
+
 struct JobMetrics
 {
     size_t execution_count{0};
     size_t success_count{0};
     size_t error_count{0};
+    size_t misfire_count{0};
 
     std::chrono::system_clock::time_point last_run_time{};
     std::chrono::milliseconds last_duration{0};
@@ -105,6 +132,8 @@ struct Job
     size_t id;
     cron::cronexpr expr;
     std::string expr_str;
+    // zone the cron expression is evaluated in, null for other jobs
+    std::shared_ptr<const TimeZone> time_zone;
     Task task;
     std::chrono::system_clock::time_point next;
 
@@ -120,15 +149,21 @@ struct Job
 
     JobMetrics metrics;
 
-    bool deleted{false};
+    MisfirePolicy misfire_policy{MisfirePolicy::FireOnce};
+    JobPriority priority{JobPriority::Normal};
+    // executor pool index, 0 is the default pool
+    size_t pool{0};
+    // set for coroutine jobs, runs instead of task
+    AsyncStart async_start;
 };
 
+// queued deadline on the monotonic clock, derived from Job::next
 struct JobNode
 {
     size_t id;
-    std::chrono::system_clock::time_point next;
+    std::chrono::steady_clock::time_point next;
 
-    JobNode(size_t id, std::chrono::system_clock::time_point next)
+    JobNode(size_t id, std::chrono::steady_clock::time_point next)
         : id(id), next(next)
     {}
 
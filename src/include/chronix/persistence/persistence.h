@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "chronix/cron_cache.h"
 #include "chronix/define.h"
 
 // file json
@@ -171,6 +172,9 @@ private:
         return nlohmann::json{{"id", job.id},
                               {"type", this->to_string(job.type)},
                               {"expr", job.expr_str},
+                              {"time_zone", job.time_zone
+                                                ? job.time_zone->name()
+                                                : std::string()},
                               {"status", this->to_string(job.status)},
                               {"result", this->to_string(job.result)}};
     }
@@ -181,10 +185,18 @@ private:
         job.id = j.at("id").get<size_t>();
         job.type = this->from_string_type(j.value("type", "Cron"));
         job.expr_str = j.at("expr").get<std::string>();
-        job.expr = cron::make_cron(job.expr_str);
+        job.expr = CronCache::shared().get(job.expr_str);
+        // 未记录时区的任务由调度器补上默认时区
+        auto time_zone = j.value("time_zone", "");
+        if (!time_zone.empty())
+        {
+            job.time_zone = TimeZone::locate(time_zone);
+        }
         job.status = this->from_string_status(j.value("status", "Pending"));
         job.result = this->from_string_result(j.value("result", "Unknown"));
-        job.next = cron::cron_next(job.expr, std::chrono::system_clock::now());
+        job.next = cron::cron_next(
+            job.expr, std::chrono::system_clock::now(),
+            job.time_zone ? *job.time_zone : *TimeZone::local());
         return job;
     }
 };
@@ -207,8 +219,10 @@ public:
     {
         std::vector<T> jobs;
         mysqlx::Table table = db.getTable("jobs");
-        mysqlx::RowResult rows =
-            table.select("id", "type", "expr", "status", "result").execute();
+        mysqlx::RowResult rows = table
+                                     .select("id", "type", "expr", "time_zone",
+                                             "status", "result")
+                                     .execute();
 
         for (auto row : rows)
         {
@@ -216,11 +230,18 @@ public:
             job.id = static_cast<size_t>(row[0].get<uint64_t>());
             job.type = this->from_string_type(row[1].get<std::string>());
             job.expr_str = row[2].get<std::string>();
-            job.expr = cron::make_cron(job.expr_str);
-            job.status = this->from_string_status(row[3].get<std::string>());
-            job.result = this->from_string_result(row[4].get<std::string>());
-            job.next =
-                cron::cron_next(job.expr, std::chrono::system_clock::now());
+            job.expr = CronCache::shared().get(job.expr_str);
+            // 未记录时区的任务由调度器补上默认时区
+            auto time_zone = row[3].get<std::string>();
+            if (!time_zone.empty())
+            {
+                job.time_zone = TimeZone::locate(time_zone);
+            }
+            job.status = this->from_string_status(row[4].get<std::string>());
+            job.result = this->from_string_result(row[5].get<std::string>());
+            job.next = cron::cron_next(
+                job.expr, std::chrono::system_clock::now(),
+                job.time_zone ? *job.time_zone : *TimeZone::local());
             jobs.emplace_back(job);
         }
 
@@ -240,6 +261,8 @@ public:
                 auto select = table.select("id").where("id = :id");
                 select.bind("id", job.id);
                 auto resp = select.execute();
+                std::string time_zone =
+                    job.time_zone ? job.time_zone->name() : std::string();
 
                 if (resp.count() > 0)
                 {
@@ -247,6 +270,7 @@ public:
                         table.update()
                             .set("type", this->to_string(job.type))
                             .set("expr", job.expr_str)
+                            .set("time_zone", time_zone)
                             .set("status", this->to_string(job.status))
                             .set("result", this->to_string(job.result))
                             .where("id = :id");
@@ -255,9 +279,11 @@ public:
                 }
                 else
                 {
-                    table.insert("id", "type", "expr", "status", "result")
+                    table
+                        .insert("id", "type", "expr", "time_zone", "status",
+                                "result")
                         .values(job.id, this->to_string(job.type), job.expr_str,
-                                this->to_string(job.status),
+                                time_zone, this->to_string(job.status),
                                 this->to_string(job.result))
                         .execute();
                 }
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#include "chronix/define.h"
+
+enum class JobQueueType
+{
+    Heap,
+    TimingWheel
+};
+
+/*
+ * job queue base
+ * Description: ordered by next run time, guarded by the scheduler mutex
+ */
+class JobQueue
+{
+public:
+    virtual ~JobQueue() = default;
+
+    // push a node, or move it if the job is already queued
+    virtual void push(const JobNode& node) = 0;
+
+    // push many nodes at once
+    virtual void push_bulk(const std::vector<JobNode>& nodes)
+    {
+        for (const auto& node : nodes)
+        {
+            push(node);
+        }
+    }
+
+    // remove the node of a job, false if it is not queued
+    virtual bool remove(size_t id) = 0;
+
+    // pop every node that is due at now
+    virtual void pop_expired(std::chrono::steady_clock::time_point now,
+                             std::vector<JobNode>& out) = 0;
+
+    // earliest time the dispatcher has to wake up, max() if empty
+    virtual std::chrono::steady_clock::time_point next_wake() = 0;
+
+    virtual bool empty() const = 0;
+
+    virtual size_t size() const = 0;
+};
+
+/*
+ * job queue indexed 4-ary heap
+ * Description: O(log n) push, pop, remove and reposition,
+ *              heap size always equals the number of queued jobs
+ */
+class HeapJobQueue : public JobQueue
+{
+public:
+    void push(const JobNode& node) override
+    {
+        auto it = position.find(node.id);
+        if (it != position.end())
+        {
+            size_t index = it->second;
+            auto previous = heap[index].next;
+            heap[index].next = node.next;
+            if (node.next < previous)
+            {
+                sift_up(index);
+            }
+            else
+            {
+                sift_down(index);
+            }
+            return;
+        }
+
+        heap.emplace_back(node);
+        position.emplace(node.id, heap.size() - 1);
+        sift_up(heap.size() - 1);
+    }
+
+    // 批量较大时追加后整体建堆, O(n)
+    void push_bulk(const std::vector<JobNode>& nodes) override
+    {
+        if (nodes.size() < heap.size())
+        {
+            JobQueue::push_bulk(nodes);
+            return;
+        }
+
+        heap.reserve(heap.size() + nodes.size());
+        position.reserve(heap.size() + nodes.size());
+        for (const auto& node : nodes)
+        {
+            auto it = position.find(node.id);
+            if (it != position.end())
+            {
+                heap[it->second].next = node.next;
+                continue;
+            }
+            heap.emplace_back(node);
+            position.emplace(node.id, heap.size() - 1);
+        }
+
+        if (heap.size() < 2)
+        {
+            return;
+        }
+        for (size_t i = (heap.size() - 2) / ARITY + 1; i-- > 0;)
+        {
+            sift_down(i);
+        }
+    }
+
+    bool remove(size_t id) override
+    {
+        auto it = position.find(id);
+        if (it == position.end())
+        {
+            return false;
+        }
+
+        erase_at(it->second);
+        shrink();
+        return true;
+    }
+
+    void pop_expired(std::chrono::steady_clock::time_point now,
+                     std::vector<JobNode>& out) override
+    {
+        while (!heap.empty() && now >= heap.front().next)
+        {
+            out.emplace_back(heap.front());
+            erase_at(0);
+        }
+        shrink();
+    }
+
+    std::chrono::steady_clock::time_point next_wake() override
+    {
+        if (heap.empty())
+        {
+            return std::chrono::steady_clock::time_point::max();
+        }
+        return heap.front().next;
+    }
+
+    bool empty() const override
+    {
+        return heap.empty();
+    }
+
+    size_t size() const override
+    {
+        return heap.size();
+    }
+
+private:
+    static constexpr size_t ARITY = 4;
+    static constexpr size_t SHRINK_MIN_CAPACITY = 1024;
+
+    void erase_at(size_t index)
+    {
+        auto removed = heap[index].next;
+        position.erase(heap[index].id);
+
+        if (index == heap.size() - 1)
+        {
+            heap.pop_back();
+            return;
+        }
+
+        heap[index] = heap.back();
+        heap.pop_back();
+        position[heap[index].id] = index;
+
+        if (heap[index].next < removed)
+        {
+            sift_up(index);
+        }
+        else
+        {
+            sift_down(index);
+        }
+    }
+
+    void sift_up(size_t index)
+    {
+        JobNode node = heap[index];
+        while (index > 0)
+        {
+            size_t parent = (index - 1) / ARITY;
+            if (!(heap[parent] > node))
+            {
+                break;
+            }
+            heap[index] = heap[parent];
+            position[heap[index].id] = index;
+            index = parent;
+        }
+        heap[index] = node;
+        position[node.id] = index;
+    }
+
+    void sift_down(size_t index)
+    {
+        JobNode node = heap[index];
+        while (true)
+        {
+            size_t first = index * ARITY + 1;
+            if (first >= heap.size())
+            {
+                break;
+            }
+
+            size_t best = first;
+            size_t last = std::min(first + ARITY, heap.size());
+            for (size_t child = first + 1; child < last; child++)
+            {
+                if (heap[best] > heap[child])
+                {
+                    best = child;
+                }
+            }
+
+            if (!(node > heap[best]))
+            {
+                break;
+            }
+            heap[index] = heap[best];
+            position[heap[index].id] = index;
+            index = best;
+        }
+        heap[index] = node;
+        position[node.id] = index;
+    }
+
+    // 大量删除后归还内存
+    void shrink()
+    {
+        if (heap.capacity() > SHRINK_MIN_CAPACITY &&
+            heap.size() < heap.capacity() / 4)
+        {
+            heap.shrink_to_fit();
+            position.rehash(0);
+        }
+    }
+
+    std::vector<JobNode> heap;
+    std::unordered_map<size_t, size_t> position;
+};
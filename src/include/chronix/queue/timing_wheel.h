@@ -0,0 +1,324 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "chronix/croncpp.h"
+#include "chronix/queue/job_queue.h"
+
+/*
+ * job queue hierarchical timing wheel
+ * Description: O(1) push, remove and expire, 1ms tick
+ *   level 0: 1000 x 1ms  (seconds wheel)
+ *   level 1: 60   x 1s   (minutes wheel)
+ *   level 2: 60   x 1min (hours wheel)
+ *   level 3: 24   x 1h   (days wheel)
+ *   level 4: 366  x 1d   (year wheel)
+ *   beyond:  overflow list, re-examined once the year wheel turns over
+ */
+class TimingWheelJobQueue : public JobQueue
+{
+public:
+    explicit TimingWheelJobQueue(std::chrono::steady_clock::time_point start =
+                                     std::chrono::steady_clock::now())
+        : current(to_tick(start))
+    {
+        for (size_t level = 0; level != LEVELS; level++)
+        {
+            wheels[level].resize(SLOTS[level]);
+            occupied[level].resize((SLOTS[level] + 63) / 64);
+        }
+    }
+
+    void push(const JobNode& node) override
+    {
+        auto it = position.find(node.id);
+        if (it != position.end())
+        {
+            erase_at(it->second);
+        }
+        else
+        {
+            count++;
+        }
+        place(node);
+    }
+
+    bool remove(size_t id) override
+    {
+        auto it = position.find(id);
+        if (it == position.end())
+        {
+            return false;
+        }
+
+        erase_at(it->second);
+        position.erase(it);
+        count--;
+        return true;
+    }
+
+    void pop_expired(std::chrono::steady_clock::time_point now,
+                     std::vector<JobNode>& out) override
+    {
+        int64_t target = to_tick(now);
+
+        if (count == 0)
+        {
+            if (target >= current)
+            {
+                current = target + 1;
+            }
+            return;
+        }
+
+        while (current <= target)
+        {
+            size_t index = current % SLOTS[0];
+            auto& slot = wheels[0][index];
+            if (!slot.empty())
+            {
+                level_count[0] -= slot.size();
+                count -= slot.size();
+                for (auto& node : slot)
+                {
+                    position.erase(node.id);
+                    out.emplace_back(node);
+                }
+                slot.clear();
+                unmark(0, index);
+            }
+
+            // 低层为空时直接跳到下一个非空槽或需要级联的边界
+            size_t level = 0;
+            while (level != LEVELS && level_count[level] == 0)
+            {
+                level++;
+            }
+
+            int64_t next = target + 1;
+            if (count != 0 && level == 0)
+            {
+                next = current - index + find_occupied(0, index + 1);
+            }
+            else if (count != 0)
+            {
+                next = (current / GRANULARITY[level] + 1) * GRANULARITY[level];
+            }
+            if (next > target + 1)
+            {
+                next = target + 1;
+            }
+
+            current = next;
+            cascade();
+        }
+    }
+
+    std::chrono::steady_clock::time_point next_wake() override
+    {
+        if (count == 0)
+        {
+            return std::chrono::steady_clock::time_point::max();
+        }
+
+        for (size_t level = 0; level != LEVELS; level++)
+        {
+            if (level_count[level] == 0)
+            {
+                continue;
+            }
+
+            // level 0 的当前槽也可能未处理, 更高层的当前槽已级联
+            int64_t base = current / GRANULARITY[level];
+            size_t from = (base + (level == 0 ? 0 : 1)) % SLOTS[level];
+            size_t index = find_occupied(level, from);
+            if (index == SLOTS[level])
+            {
+                index = find_occupied(level, 0);
+            }
+            int64_t offset =
+                (index + SLOTS[level] - base % SLOTS[level]) % SLOTS[level];
+            if (offset == 0 && level != 0)
+            {
+                offset = SLOTS[level];
+            }
+            return from_tick((base + offset) * GRANULARITY[level]);
+        }
+
+        return from_tick((current / GRANULARITY[LEVELS] + 1) *
+                         GRANULARITY[LEVELS]);
+    }
+
+    bool empty() const override
+    {
+        return count == 0;
+    }
+
+    size_t size() const override
+    {
+        return count;
+    }
+
+private:
+    struct Location
+    {
+        size_t level;
+        size_t slot;
+        size_t index;
+    };
+
+    static constexpr size_t LEVELS = 5;
+    static constexpr std::array<size_t, LEVELS> SLOTS{1000, 60, 60, 24, 366};
+    static constexpr std::array<int64_t, LEVELS + 1> GRANULARITY{
+        1,
+        1000,
+        60 * 1000,
+        60 * 60 * 1000,
+        24 * 60 * 60 * 1000,
+        366LL * 24 * 60 * 60 * 1000};
+
+    // 向上取整，保证不会早于 node.next 触发
+    static int64_t to_tick(std::chrono::steady_clock::time_point tp)
+    {
+        return std::chrono::ceil<std::chrono::milliseconds>(
+                   tp.time_since_epoch())
+            .count();
+    }
+
+    static std::chrono::steady_clock::time_point from_tick(int64_t tick)
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::milliseconds(tick));
+    }
+
+    // 放入与当前时间处于同一上级槽位的最低层
+    void place(const JobNode& node)
+    {
+        int64_t expire = to_tick(node.next);
+        if (expire < current)
+        {
+            expire = current;
+        }
+
+        for (size_t level = 0; level != LEVELS; level++)
+        {
+            if (expire / GRANULARITY[level + 1] ==
+                current / GRANULARITY[level + 1])
+            {
+                size_t index = (expire / GRANULARITY[level]) % SLOTS[level];
+                auto& slot = wheels[level][index];
+                slot.emplace_back(node);
+                position[node.id] = Location{level, index, slot.size() - 1};
+                mark(level, index);
+                level_count[level]++;
+                return;
+            }
+        }
+
+        overflow.emplace_back(node);
+        position[node.id] = Location{LEVELS, 0, overflow.size() - 1};
+    }
+
+    // 与末尾交换后删除, 不修改 position 中被删除的条目
+    void erase_at(const Location& location)
+    {
+        auto& slot = location.level == LEVELS
+                         ? overflow
+                         : wheels[location.level][location.slot];
+
+        if (location.index != slot.size() - 1)
+        {
+            slot[location.index] = slot.back();
+            position[slot[location.index].id].index = location.index;
+        }
+        slot.pop_back();
+
+        if (location.level != LEVELS)
+        {
+            level_count[location.level]--;
+            if (slot.empty())
+            {
+                unmark(location.level, location.slot);
+            }
+        }
+    }
+
+    // 跨越边界时由高层向低层重新分布
+    void cascade()
+    {
+        if (current % GRANULARITY[LEVELS] == 0 && !overflow.empty())
+        {
+            std::vector<JobNode> pending;
+            pending.swap(overflow);
+            for (auto& node : pending)
+            {
+                place(node);
+            }
+        }
+
+        for (size_t level = LEVELS - 1; level != 0; level--)
+        {
+            if (current % GRANULARITY[level] != 0 || level_count[level] == 0)
+            {
+                continue;
+            }
+
+            size_t index = (current / GRANULARITY[level]) % SLOTS[level];
+            auto& slot = wheels[level][index];
+            if (slot.empty())
+            {
+                continue;
+            }
+
+            std::vector<JobNode> pending;
+            pending.swap(slot);
+            unmark(level, index);
+            level_count[level] -= pending.size();
+            for (auto& node : pending)
+            {
+                place(node);
+            }
+        }
+    }
+
+    void mark(size_t level, size_t index)
+    {
+        occupied[level][index / 64] |= uint64_t(1) << (index % 64);
+    }
+
+    void unmark(size_t level, size_t index)
+    {
+        occupied[level][index / 64] &= ~(uint64_t(1) << (index % 64));
+    }
+
+    // 第一个 >= from 的非空槽, 没有则返回 SLOTS[level]
+    size_t find_occupied(size_t level, size_t from) const
+    {
+        const auto& bits = occupied[level];
+        for (size_t word = from / 64; word < bits.size(); word++)
+        {
+            uint64_t value = bits[word];
+            if (word == from / 64)
+            {
+                value &= ~uint64_t(0) << (from % 64);
+            }
+            if (value != 0)
+            {
+                return word * 64 + cron::detail::count_trailing_zeros(value);
+            }
+        }
+        return SLOTS[level];
+    }
+
+    std::array<std::vector<std::vector<JobNode>>, LEVELS> wheels;
+    std::array<std::vector<uint64_t>, LEVELS> occupied;
+    std::array<size_t, LEVELS> level_count{};
+    std::vector<JobNode> overflow;
+    std::unordered_map<size_t, Location> position;
+    int64_t current;
+    size_t count{0};
+};
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * generational slot map
+ * Description: values are stored densely, ids carry a generation
+ *   id:     high 32 bits generation, low 32 bits slot * stride + offset
+ *   lookup: one array index plus a generation check, stale ids miss
+ *   erase:  the last value is moved into the hole, O(1)
+ */
+template <typename T>
+class SlotMap
+{
+public:
+    // stride/offset let several maps share one id space without collisions
+    explicit SlotMap(uint32_t stride = 1, uint32_t offset = 0)
+        : stride(stride), offset(offset)
+    {
+        if (stride == 0 || offset >= stride)
+        {
+            throw std::runtime_error("invalid slot map stride");
+        }
+    }
+
+    // insert a value, returns its id
+    uint64_t insert(T value)
+    {
+        uint32_t slot = acquire_slot();
+        uint64_t id = make_id(slots[slot].generation, slot);
+
+        slots[slot].index = static_cast<uint32_t>(values.size());
+        values.emplace_back(std::move(value));
+        value_ids.emplace_back(id);
+        return id;
+    }
+
+    // insert a value under a given id, replacing any value in that slot
+    void insert_at(uint64_t id, T value)
+    {
+        if (!owns(id))
+        {
+            throw std::runtime_error("ID " + std::to_string(id) +
+                                     " does not belong to this slot map");
+        }
+
+        uint32_t slot = slot_of(id);
+        if (slot >= slots.size())
+        {
+            // 新增的空槽加入空闲列表
+            for (uint32_t i = static_cast<uint32_t>(slots.size()); i != slot;
+                 i++)
+            {
+                free_slots.emplace_back(i);
+            }
+            slots.resize(slot + 1);
+        }
+
+        auto& entry = slots[slot];
+        entry.generation = generation_of(id);
+        if (entry.index != INVALID)
+        {
+            values[entry.index] = std::move(value);
+            value_ids[entry.index] = id;
+            return;
+        }
+
+        // 空闲列表中的该槽在出栈时跳过
+        entry.index = static_cast<uint32_t>(values.size());
+        values.emplace_back(std::move(value));
+        value_ids.emplace_back(id);
+    }
+
+    // value of an id, nullptr if the id is stale or unknown
+    T* find(uint64_t id)
+    {
+        if (!owns(id))
+        {
+            return nullptr;
+        }
+
+        uint32_t slot = slot_of(id);
+        if (slot >= slots.size())
+        {
+            return nullptr;
+        }
+
+        const auto& entry = slots[slot];
+        if (entry.index == INVALID || entry.generation != generation_of(id))
+        {
+            return nullptr;
+        }
+        return &values[entry.index];
+    }
+
+    bool contains(uint64_t id)
+    {
+        return find(id) != nullptr;
+    }
+
+    // id of the live value in the slot of an id, whatever its generation,
+    // 0 if the slot is empty
+    uint64_t occupant(uint64_t id) const
+    {
+        if (!owns(id) || slot_of(id) >= slots.size())
+        {
+            return 0;
+        }
+
+        uint32_t index = slots[slot_of(id)].index;
+        return index == INVALID ? 0 : value_ids[index];
+    }
+
+    // erase the value of an id, false if the id is stale or unknown
+    bool erase(uint64_t id)
+    {
+        if (find(id) == nullptr)
+        {
+            return false;
+        }
+
+        uint32_t slot = slot_of(id);
+        uint32_t index = slots[slot].index;
+        uint32_t last = static_cast<uint32_t>(values.size()) - 1;
+        if (index != last)
+        {
+            values[index] = std::move(values[last]);
+            value_ids[index] = value_ids[last];
+            slots[slot_of(value_ids[index])].index = index;
+        }
+        values.pop_back();
+        value_ids.pop_back();
+
+        // 代数递增, 旧ID失效
+        slots[slot].index = INVALID;
+        slots[slot].generation = next_generation(slots[slot].generation);
+        free_slots.emplace_back(slot);
+        return true;
+    }
+
+    void reserve(size_t size)
+    {
+        values.reserve(size);
+        value_ids.reserve(size);
+    }
+
+    size_t size() const
+    {
+        return values.size();
+    }
+
+    bool empty() const
+    {
+        return values.empty();
+    }
+
+    // dense iteration over values, invalidated by insert and erase
+    typename std::vector<T>::iterator begin()
+    {
+        return values.begin();
+    }
+
+    typename std::vector<T>::iterator end()
+    {
+        return values.end();
+    }
+
+    typename std::vector<T>::const_iterator begin() const
+    {
+        return values.begin();
+    }
+
+    typename std::vector<T>::const_iterator end() const
+    {
+        return values.end();
+    }
+
+private:
+    struct Slot
+    {
+        uint32_t generation{1};
+        uint32_t index{INVALID};
+    };
+
+    static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+    static uint32_t generation_of(uint64_t id)
+    {
+        return static_cast<uint32_t>(id >> 32);
+    }
+
+    // 代数从1开始, 保证ID不为0
+    static uint32_t next_generation(uint32_t generation)
+    {
+        return generation == std::numeric_limits<uint32_t>::max()
+                   ? 1
+                   : generation + 1;
+    }
+
+    bool owns(uint64_t id) const
+    {
+        return static_cast<uint32_t>(id) % stride == offset &&
+               generation_of(id) != 0;
+    }
+
+    uint32_t slot_of(uint64_t id) const
+    {
+        return static_cast<uint32_t>(id) / stride;
+    }
+
+    uint64_t make_id(uint32_t generation, uint32_t slot) const
+    {
+        return (uint64_t(generation) << 32) |
+               (uint64_t(slot) * stride + offset);
+    }
+
+    uint32_t acquire_slot()
+    {
+        while (!free_slots.empty())
+        {
+            uint32_t slot = free_slots.back();
+            free_slots.pop_back();
+            if (slots[slot].index == INVALID)
+            {
+                return slot;
+            }
+        }
+
+        if ((uint64_t(slots.size()) + 1) * stride > INVALID)
+        {
+            throw std::runtime_error("slot map is full");
+        }
+        slots.emplace_back();
+        return static_cast<uint32_t>(slots.size() - 1);
+    }
+
+    const uint32_t stride;
+    const uint32_t offset;
+
+    std::vector<T> values;
+    std::vector<uint64_t> value_ids;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> free_slots;
+};
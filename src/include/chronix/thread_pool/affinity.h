@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// cpus of one NUMA node, read from /sys/devices/system/node
+struct NumaNode
+{
+    size_t id;
+    std::vector<size_t> cpus;
+};
+
+// parse a kernel cpu list such as "0-3,8,10-11"
+inline std::vector<size_t> parse_cpu_list(const std::string& list)
+{
+    std::vector<size_t> cpus;
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ','))
+    {
+        range.erase(std::remove_if(range.begin(), range.end(),
+                                   [](char c) { return std::isspace(c); }),
+                    range.end());
+        if (range.empty())
+        {
+            continue;
+        }
+
+        try
+        {
+            auto dash = range.find('-');
+            size_t first = std::stoul(range.substr(0, dash));
+            size_t last = dash == std::string::npos
+                              ? first
+                              : std::stoul(range.substr(dash + 1));
+            if (first > last)
+            {
+                throw std::invalid_argument(range);
+            }
+            for (size_t cpu = first; cpu <= last; cpu++)
+            {
+                cpus.emplace_back(cpu);
+            }
+        }
+        catch (const std::exception&)
+        {
+            throw std::runtime_error("Invalid cpu list: " + list);
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+// online NUMA nodes, a single node with every cpu if the topology is unknown
+inline std::vector<NumaNode> numa_nodes()
+{
+    std::vector<NumaNode> nodes;
+
+#ifdef __linux__
+    // 只读 sysfs, 不依赖 libnuma
+    const std::string root = "/sys/devices/system/node/";
+    if (DIR* dir = opendir(root.c_str()))
+    {
+        while (dirent* entry = readdir(dir))
+        {
+            std::string name = entry->d_name;
+            if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+                name.find_first_not_of("0123456789", 4) != std::string::npos)
+            {
+                continue;
+            }
+
+            std::ifstream file(root + name + "/cpulist");
+            std::string list;
+            if (!std::getline(file, list))
+            {
+                continue;
+            }
+
+            auto cpus = parse_cpu_list(list);
+            if (!cpus.empty())
+            {
+                nodes.push_back(NumaNode{std::stoul(name.substr(4)), cpus});
+            }
+        }
+        closedir(dir);
+    }
+#endif
+
+    if (nodes.empty())
+    {
+        NumaNode node{0, {}};
+        size_t count = std::max(std::thread::hardware_concurrency(), 1u);
+        for (size_t cpu = 0; cpu != count; cpu++)
+        {
+            node.cpus.emplace_back(cpu);
+        }
+        nodes.emplace_back(std::move(node));
+    }
+
+    std::sort(nodes.begin(), nodes.end(),
+              [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+    return nodes;
+}
+
+// restrict a thread to cpus, false if unsupported or refused by the kernel
+inline bool pin_thread(std::thread::native_handle_type handle,
+                       const std::vector<size_t>& cpus)
+{
+#ifdef __linux__
+    if (cpus.empty())
+    {
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(handle, sizeof(set), &set) == 0;
+#else
+    (void)handle;
+    (void)cpus;
+    return false;
+#endif
+}
+
+inline bool pin_current_thread(const std::vector<size_t>& cpus)
+{
+#ifdef __linux__
+    return pin_thread(pthread_self(), cpus);
+#else
+    (void)cpus;
+    return false;
+#endif
+}
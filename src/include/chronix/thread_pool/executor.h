@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "chronix/define.h"
+#include "chronix/thread_pool/unique_function.h"
+
+// point-in-time load of an executor
+struct ExecutorMetrics
+{
+    size_t threads{0};
+    size_t active_threads{0};
+    size_t queued{0};
+    size_t max_queue{0};
+    size_t completed{0};
+    // completed tasks that threw, the exception itself is dropped
+    size_t failed{0};
+    size_t rejected{0};
+    size_t dropped{0};
+    size_t caller_runs{0};
+    size_t blocked{0};
+
+    double utilization() const
+    {
+        return threads > 0 ? static_cast<double>(active_threads) / threads
+                           : 0.0;
+    }
+};
+
+/*
+ * executor
+ * Description: runs posted tasks on its own threads, the scheduler only
+ *              needs fire-and-forget submission
+ */
+class Executor
+{
+public:
+    virtual ~Executor() = default;
+
+    // post a task without a future
+    virtual void post(unique_function<void()> task) = 0;
+
+    // post into a priority lane, executors without lanes ignore it
+    virtual void post(unique_function<void()> task, JobPriority priority)
+    {
+        (void)priority;
+        post(std::move(task));
+    }
+
+    // post many tasks into one lane, tasks left in the vector did not run
+    virtual void post_bulk(std::vector<unique_function<void()>>& tasks,
+                           JobPriority priority)
+    {
+        for (auto& task : tasks)
+        {
+            post(std::move(task), priority);
+        }
+        tasks.clear();
+    }
+
+    // number of worker threads right now
+    virtual size_t get_thread_count() const = 0;
+
+    // thread, queue and completion counters
+    virtual ExecutorMetrics get_metrics() const
+    {
+        ExecutorMetrics metrics;
+        metrics.threads = get_thread_count();
+        return metrics;
+    }
+};
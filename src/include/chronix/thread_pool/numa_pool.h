@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "chronix/thread_pool/affinity.h"
+#include "chronix/thread_pool/executor.h"
+#include "chronix/thread_pool/thread_pool.h"
+
+/*
+ * numa pool
+ * Description: one ThreadPool per NUMA node with its own queue,
+ *   its workers pinned to the cpus of the node,
+ *   tasks posted by a worker stay on its node,
+ *   tasks posted from other threads go to the least loaded node
+ */
+class NumaPool : public Executor
+{
+public:
+    // threads are per node, a non-empty cpus keeps only those cpus and
+    // skips nodes left without any
+    NumaPool(size_t min_threads, size_t max_threads,
+             const std::vector<size_t>& cpus = {})
+    {
+        for (auto& node : numa_nodes())
+        {
+            if (!cpus.empty())
+            {
+                std::vector<size_t> kept;
+                std::set_intersection(node.cpus.begin(), node.cpus.end(),
+                                      cpus.begin(), cpus.end(),
+                                      std::back_inserter(kept));
+                node.cpus = std::move(kept);
+            }
+            if (node.cpus.empty())
+            {
+                continue;
+            }
+
+            auto pool = std::make_unique<ThreadPool>(min_threads, max_threads);
+            pool->set_cpu_affinity(node.cpus);
+            pools.emplace_back(std::move(pool));
+            nodes.emplace_back(std::move(node));
+        }
+
+        if (pools.empty())
+        {
+            throw std::runtime_error("No NUMA node has an allowed cpu");
+        }
+    }
+
+    NumaPool(const NumaPool&) = delete;
+    NumaPool& operator=(const NumaPool&) = delete;
+
+    using Executor::post;
+
+    void post(unique_function<void()> task) override
+    {
+        post(std::move(task), JobPriority::Normal);
+    }
+
+    void post(unique_function<void()> task, JobPriority priority) override
+    {
+        pools[pick_node()]->post(std::move(task), priority);
+    }
+
+    // a worker keeps the batch on its node, other threads split it evenly
+    void post_bulk(std::vector<unique_function<void()>>& tasks,
+                   JobPriority priority) override
+    {
+        if (tasks.empty())
+        {
+            return;
+        }
+        if (local_node() != pools.size() || pools.size() == 1)
+        {
+            pools[pick_node()]->post_bulk(tasks, priority);
+            return;
+        }
+
+        size_t first = pick_node();
+        size_t chunk = (tasks.size() + pools.size() - 1) / pools.size();
+        std::vector<unique_function<void()>> part;
+        std::exception_ptr error;
+        for (size_t i = 0, offset = 0; offset < tasks.size();
+             i++, offset += chunk)
+        {
+            size_t end = std::min(offset + chunk, tasks.size());
+            part.clear();
+            for (size_t j = offset; j != end; j++)
+            {
+                part.emplace_back(std::move(tasks[j]));
+            }
+
+            try
+            {
+                pools[(first + i) % pools.size()]->post_bulk(part, priority);
+            }
+            catch (const std::exception&)
+            {
+                // 未投递的任务放回原位, 交还调用者
+                for (size_t j = 0; j != part.size(); j++)
+                {
+                    tasks[offset + j] = std::move(part[j]);
+                }
+                error = std::current_exception();
+            }
+        }
+
+        tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
+                                   [](const auto& task) { return !task; }),
+                    tasks.end());
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    size_t get_thread_count() const override
+    {
+        size_t threads{0};
+        for (const auto& pool : pools)
+        {
+            threads += pool->get_thread_count();
+        }
+        return threads;
+    }
+
+    ExecutorMetrics get_metrics() const override
+    {
+        ExecutorMetrics metrics;
+        for (const auto& pool : pools)
+        {
+            auto node = pool->get_metrics();
+            metrics.threads += node.threads;
+            metrics.active_threads += node.active_threads;
+            metrics.queued += node.queued;
+            metrics.max_queue += node.max_queue;
+            metrics.completed += node.completed;
+            metrics.failed += node.failed;
+            metrics.rejected += node.rejected;
+            metrics.dropped += node.dropped;
+            metrics.caller_runs += node.caller_runs;
+            metrics.blocked += node.blocked;
+        }
+        return metrics;
+    }
+
+    size_t get_node_count() const
+    {
+        return nodes.size();
+    }
+
+    const NumaNode& get_node(size_t index) const
+    {
+        return nodes.at(index);
+    }
+
+    // pool of one node, to tune its queue, aging or worker wait
+    ThreadPool& get_node_pool(size_t index)
+    {
+        return *pools.at(index);
+    }
+
+private:
+    // node of the calling worker, pools.size() on other threads
+    size_t local_node() const
+    {
+        ThreadPool* current = ThreadPool::current();
+        for (size_t i = 0; i != pools.size(); i++)
+        {
+            if (pools[i].get() == current)
+            {
+                return i;
+            }
+        }
+        return pools.size();
+    }
+
+    // 外部线程从轮转位置起选排队最少的节点
+    size_t pick_node()
+    {
+        size_t local = local_node();
+        if (local != pools.size())
+        {
+            return local;
+        }
+
+        size_t start = next_node.fetch_add(1, std::memory_order_relaxed);
+        size_t best = start % pools.size();
+        for (size_t i = 1; i != pools.size(); i++)
+        {
+            size_t node = (start + i) % pools.size();
+            if (pools[node]->get_queue_depth() <
+                pools[best]->get_queue_depth())
+            {
+                best = node;
+            }
+        }
+        return best;
+    }
+
+    std::vector<NumaNode> nodes;
+    std::vector<std::unique_ptr<ThreadPool>> pools;
+    std::atomic<size_t> next_node{0};
+};
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <future>
@@ -8,9 +11,56 @@
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
-class ThreadPool
+#include "chronix/thread_pool/affinity.h"
+#include "chronix/thread_pool/executor.h"
+
+enum class ScalingEvent
+{
+    Grow,
+    Shrink
+};
+
+using ScalingCallback = std::function<void(ScalingEvent, size_t threads)>;
+
+// what post does when max_queue tasks are already waiting,
+// Block never blocks a worker of the pool itself, its tasks go past the limit
+enum class QueueFullPolicy
+{
+    Block,
+    Reject,
+    DropOldest,
+    CallerRuns
+};
+
+// how long an idle worker spins, then yields, before it parks
+struct WorkerWait
+{
+    std::chrono::microseconds spin{0};
+    std::chrono::microseconds yield{0};
+};
+
+/*
+ * elastic thread pool
+ * Description: starts with min_threads workers,
+ *   grows: a task is queued with no idle worker to take it,
+ *          or a task waited longer than grow_wait in the queue
+ *   shrinks: a worker idle for keep_alive exits while above min_threads,
+ *            its std::thread is joined and removed on the next post
+ *   lanes: one FIFO per JobPriority, the highest lane is served first,
+ *          a task rises one lane per aging interval it waits
+ *   bounded: with max_queue set, a full queue blocks the submitter,
+ *            rejects the task, drops the oldest lowest-lane task,
+ *            or runs the task on the submitting thread
+ *   waiting: an idle worker spins, then yields, then parks,
+ *            at most half of the cores spin at once,
+ *            workers at min_threads park without a timeout
+ *   affinity: with a cpu set given, every worker is pinned to it
+ */
+class ThreadPool : public Executor
 {
 public:
     explicit ThreadPool(
@@ -27,9 +77,10 @@ public:
             throw std::runtime_error("min_threads > max_threads");
         }
 
+        std::lock_guard<std::mutex> lock(queue_mutex);
         for (size_t i = 0; i != min_threads; i++)
         {
-            workers.emplace_back(&ThreadPool::worker_thread, this);
+            spawn_worker();
         }
     }
 
@@ -44,61 +95,631 @@ public:
     {
         using return_type = typename std::invoke_result<F, Args...>::type;
 
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
+        // packaged_task 只能移动, 直接存入 unique_function
+        std::packaged_task<return_type()> task(
             std::bind(std::forward<F>(f), std::forward<Args>(args)...));
 
-        std::future<return_type> resp = task->get_future();
+        std::future<return_type> resp = task.get_future();
+        post(std::move(task));
+        return resp;
+    }
+
+    // submit a task without a future, no shared state is allocated
+    template <class F, class... Args>
+    void submit_detached(F&& f, Args&&... args)
+    {
+        post([f = std::forward<F>(f),
+              args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+            std::apply(f, std::move(args));
+        });
+    }
+
+    // post a task without a future, no packaged_task allocation
+    void post(unique_function<void()> task) override
+    {
+        post(std::move(task), JobPriority::Normal);
+    }
+
+    // post a task into the lane of its priority
+    void post(unique_function<void()> task, JobPriority priority) override
+    {
+        std::vector<std::thread> exited;
+        Task dropped;
+        bool grown{false};
         {
-            std::lock_guard<std::mutex> lock(queue_mutex);
+            std::unique_lock<std::mutex> lock(queue_mutex);
 
             if (stop_flag)
             {
-                throw std::runtime_error("submit on stopped ThreadPool");
+                throw std::runtime_error("post on stopped ThreadPool");
+            }
+            if (max_queue != 0 && queued >= max_queue)
+            {
+                switch (full_policy)
+                {
+                case QueueFullPolicy::Block:
+                    // 工作线程等待自己的队列腾出位置会死锁
+                    if (current_pool() == this)
+                    {
+                        break;
+                    }
+                    blocked_count++;
+                    not_full.wait(lock, [this]() {
+                        return stop_flag || max_queue == 0 ||
+                               queued < max_queue;
+                    });
+                    if (stop_flag)
+                    {
+                        throw std::runtime_error("post on stopped ThreadPool");
+                    }
+                    break;
+                case QueueFullPolicy::Reject:
+                    rejected_count++;
+                    throw std::runtime_error("ThreadPool queue is full");
+                case QueueFullPolicy::DropOldest:
+                    // 锁外析构被丢弃的任务
+                    dropped = pop_oldest();
+                    dropped_count++;
+                    break;
+                case QueueFullPolicy::CallerRuns:
+                    caller_run_count++;
+                    lock.unlock();
+                    task();
+                    return;
+                }
             }
 
-            tasks.emplace([task]() { (*task)(); });
+            lanes[static_cast<size_t>(priority)].emplace(
+                std::move(task), std::chrono::steady_clock::now());
+            queued++;
+
+            // 排队任务多于空闲线程时扩容
+            if (queued > idle_threads)
+            {
+                grown = spawn_worker();
+            }
+            exited.swap(retired);
+        }
+
+        // 有线程在自旋时由它取走任务, 省去一次唤醒
+        if (spinning_threads == 0)
+        {
+            condition.notify_one();
+        }
+
+        join_all(exited);
+        if (grown)
+        {
+            notify_scaling(ScalingEvent::Grow);
         }
-        condition.notify_one();
-        return resp;
+    }
+
+    // submit a range of callables into one lane under a single lock
+    template <typename Range>
+    void submit_bulk(Range&& range, JobPriority priority = JobPriority::Normal)
+    {
+        std::vector<unique_function<void()>> tasks;
+        for (auto&& f : range)
+        {
+            tasks.emplace_back(std::forward<decltype(f)>(f));
+        }
+        post_bulk(tasks, priority);
+    }
+
+    // enqueue all tasks under one lock and wake one idle worker per task,
+    // tasks that do not fit follow the full policy
+    void post_bulk(std::vector<unique_function<void()>>& tasks,
+                   JobPriority priority) override
+    {
+        if (tasks.empty())
+        {
+            return;
+        }
+
+        std::vector<std::thread> exited;
+        std::vector<unique_function<void()>> dropped;
+        std::vector<unique_function<void()>> caller_tasks;
+        size_t added{0};
+        size_t rejected{0};
+        size_t grown{0};
+        size_t wake{0};
+        bool wake_all{false};
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+
+            if (stop_flag)
+            {
+                throw std::runtime_error("post on stopped ThreadPool");
+            }
+
+            auto& lane = lanes[static_cast<size_t>(priority)];
+            auto now = std::chrono::steady_clock::now();
+            bool worker = current_pool() == this;
+            for (auto& task : tasks)
+            {
+                if (max_queue != 0 && queued >= max_queue)
+                {
+                    switch (full_policy)
+                    {
+                    case QueueFullPolicy::Block:
+                        // 本池的工作线程不等待, 所有线程都在等待时无人出队
+                        if (worker)
+                        {
+                            break;
+                        }
+                        // 先唤醒工作线程取走已入队的任务再等待
+                        blocked_count++;
+                        condition.notify_all();
+                        not_full.wait(lock, [this]() {
+                            return stop_flag || max_queue == 0 ||
+                                   queued < max_queue;
+                        });
+                        if (stop_flag)
+                        {
+                            throw std::runtime_error(
+                                "post on stopped ThreadPool");
+                        }
+                        break;
+                    case QueueFullPolicy::Reject:
+                        rejected_count++;
+                        rejected++;
+                        continue;
+                    case QueueFullPolicy::DropOldest:
+                        dropped.emplace_back(pop_oldest());
+                        dropped_count++;
+                        break;
+                    case QueueFullPolicy::CallerRuns:
+                        caller_run_count++;
+                        caller_tasks.emplace_back(std::move(task));
+                        continue;
+                    }
+                }
+
+                lane.emplace(std::move(task), now);
+                queued++;
+                added++;
+            }
+
+            // 排队任务多于空闲线程时一次扩容到位
+            while (queued > idle_threads + grown && spawn_worker())
+            {
+                grown++;
+            }
+            wake = std::min(added, idle_threads.load());
+            wake_all = wake != 0 && wake == idle_threads;
+            exited.swap(retired);
+        }
+
+        if (wake_all)
+        {
+            condition.notify_all();
+        }
+        else
+        {
+            for (size_t i = 0; i != wake; i++)
+            {
+                condition.notify_one();
+            }
+        }
+
+        // 被拒绝的任务留在 tasks 中, 由调用者决定如何处理
+        if (rejected == 0)
+        {
+            tasks.clear();
+        }
+        dropped.clear();
+        for (auto& task : caller_tasks)
+        {
+            task();
+        }
+
+        join_all(exited);
+        for (size_t i = 0; i != grown; i++)
+        {
+            notify_scaling(ScalingEvent::Grow);
+        }
+        if (rejected != 0)
+        {
+            throw std::runtime_error("ThreadPool queue is full");
+        }
+    }
+
+    // a worker idle for this long exits while above min_threads
+    void set_keep_alive(std::chrono::milliseconds keep_alive_time)
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        keep_alive = keep_alive_time;
+    }
+
+    // spin and yield budget of an idle worker, zero parks at once
+    void set_worker_wait(WorkerWait wait)
+    {
+        spin_time = wait.spin;
+        yield_time = wait.yield;
+    }
+
+    WorkerWait get_worker_wait() const
+    {
+        return WorkerWait{spin_time.load(), yield_time.load()};
+    }
+
+    // pin current and future workers to cpus, empty lets them float
+    void set_cpu_affinity(std::vector<size_t> cpus)
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        cpu_affinity = std::move(cpus);
+        if (cpu_affinity.empty())
+        {
+            return;
+        }
+        for (auto& [id, worker] : workers)
+        {
+            pin_thread(worker.native_handle(), cpu_affinity);
+        }
+    }
+
+    std::vector<size_t> get_cpu_affinity()
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        return cpu_affinity;
+    }
+
+    // pool of the calling worker thread, nullptr on other threads
+    static ThreadPool* current()
+    {
+        return current_pool();
+    }
+
+    // a task waiting longer than this in the queue adds a worker
+    void set_grow_wait(std::chrono::milliseconds grow_wait_time)
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        grow_wait = grow_wait_time;
+    }
+
+    // waiting this long raises a task one lane, zero for strict priority
+    void set_aging(std::chrono::milliseconds aging_time)
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        aging = aging_time;
+    }
+
+    // limit waiting tasks, zero for unbounded
+    void set_max_queue(size_t max_queue_size,
+                       QueueFullPolicy policy = QueueFullPolicy::Reject)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            max_queue = max_queue_size;
+            full_policy = policy;
+        }
+        not_full.notify_all();
+    }
+
+    size_t get_queue_depth() const
+    {
+        return queued.load();
+    }
+
+    ExecutorMetrics get_metrics() const override
+    {
+        ExecutorMetrics metrics;
+        metrics.threads = thread_count;
+        metrics.active_threads =
+            metrics.threads - std::min(metrics.threads, idle_threads.load());
+        metrics.queued = queued;
+        metrics.max_queue = max_queue;
+        metrics.completed = completed_count;
+        metrics.failed = failed_count;
+        metrics.rejected = rejected_count;
+        metrics.dropped = dropped_count;
+        metrics.caller_runs = caller_run_count;
+        metrics.blocked = blocked_count;
+        return metrics;
+    }
+
+    // number of tasks waiting in a lane
+    size_t get_queued_count(JobPriority priority)
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        return lanes[static_cast<size_t>(priority)].size();
+    }
+
+    // called after every grow or shrink with the new thread count
+    void set_scaling_callback(ScalingCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        scaling_callback = std::move(callback);
+    }
+
+    size_t get_thread_count() const override
+    {
+        return thread_count.load();
+    }
+
+    size_t get_idle_thread_count() const
+    {
+        return idle_threads.load();
+    }
+
+    size_t get_grow_count() const
+    {
+        return grow_count.load();
+    }
+
+    size_t get_shrink_count() const
+    {
+        return shrink_count.load();
+    }
+
+    size_t get_min_threads() const
+    {
+        return min_threads;
+    }
+
+    size_t get_max_threads() const
+    {
+        return max_threads;
     }
 
     ~ThreadPool()
     {
+        std::vector<std::thread> exited;
         {
             std::lock_guard<std::mutex> lock(queue_mutex);
             stop_flag = true;
         }
 
         condition.notify_all();
+        not_full.notify_all();
 
-        for (std::thread& worker : workers)
         {
-            if (worker.joinable())
+            // 停止后不再扩缩容, 线程表不再变化
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            for (auto& [id, worker] : workers)
+            {
+                exited.emplace_back(std::move(worker));
+            }
+            workers.clear();
+            for (auto& worker : retired)
             {
-                worker.join();
+                exited.emplace_back(std::move(worker));
             }
+            retired.clear();
         }
+
+        join_all(exited);
     }
 
 private:
-    using Task = std::function<void()>;
+    using Task = unique_function<void()>;
+
+    static constexpr size_t LANES = static_cast<size_t>(JobPriority::High) + 1;
+    // pause instructions between two clock reads while spinning
+    static constexpr size_t SPIN_BATCH = 64;
+
+    struct QueuedTask
+    {
+        QueuedTask(Task task, std::chrono::steady_clock::time_point enqueued)
+            : task(std::move(task)), enqueued(enqueued)
+        {}
+
+        Task task;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    static void join_all(std::vector<std::thread>& threads)
+    {
+        for (auto& thread : threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+    }
+
+    // caller holds queue_mutex
+    bool spawn_worker()
+    {
+        if (stop_flag || workers.size() >= max_threads)
+        {
+            return false;
+        }
+
+        size_t id = next_worker_id++;
+        workers.emplace(id, std::thread(&ThreadPool::worker_thread, this, id));
+        thread_count = workers.size();
+        if (workers.size() > min_threads)
+        {
+            grow_count++;
+        }
+        return true;
+    }
+
+    // caller holds queue_mutex, the thread object is joined later
+    void retire_worker(size_t id)
+    {
+        auto it = workers.find(id);
+        retired.emplace_back(std::move(it->second));
+        workers.erase(it);
+        thread_count = workers.size();
+        shrink_count++;
+    }
+
+    void notify_scaling(ScalingEvent event)
+    {
+        ScalingCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            callback = scaling_callback;
+        }
+        if (callback)
+        {
+            callback(event, thread_count.load());
+        }
+    }
+
+    // oldest task of the lowest non-empty lane, caller holds queue_mutex
+    Task pop_oldest()
+    {
+        for (auto& lane : lanes)
+        {
+            if (!lane.empty())
+            {
+                Task task = std::move(lane.front().task);
+                lane.pop();
+                queued--;
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    // lane whose head has the highest aged priority, ties go to the oldest,
+    // caller holds queue_mutex and at least one task is queued
+    size_t pick_lane(std::chrono::steady_clock::time_point now) const
+    {
+        size_t best = LANES;
+        size_t best_level = 0;
+        for (size_t lane = LANES; lane-- > 0;)
+        {
+            if (lanes[lane].empty())
+            {
+                continue;
+            }
+
+            // 等待越久等级越高, 低优先级任务不会饿死
+            size_t level = lane;
+            auto& head = lanes[lane].front();
+            if (aging.count() > 0)
+            {
+                level += static_cast<size_t>((now - head.enqueued) / aging);
+                level = std::min(level, LANES - 1);
+            }
+
+            if (best == LANES || level > best_level ||
+                (level == best_level &&
+                 head.enqueued < lanes[best].front().enqueued))
+            {
+                best = lane;
+                best_level = level;
+            }
+        }
+        return best;
+    }
+
+    static ThreadPool*& current_pool()
+    {
+        static thread_local ThreadPool* pool{nullptr};
+        return pool;
+    }
+
+    static void cpu_relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    // at most half of the cores spin, none on a single core
+    static size_t max_spinning_threads()
+    {
+        static const size_t limit = std::thread::hardware_concurrency() / 2;
+        return limit;
+    }
+
+    // spin then yield until a task is queued or the budget runs out,
+    // true if the worker spun at all
+    bool spin_wait()
+    {
+        auto spin = spin_time.load();
+        auto total = spin + yield_time.load();
+        if (total.count() == 0)
+        {
+            return false;
+        }
+
+        // 自旋线程过多会与生产者争抢 CPU
+        if (spinning_threads.fetch_add(1) >= max_spinning_threads())
+        {
+            spinning_threads--;
+            return false;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        while (queued.load(std::memory_order_relaxed) == 0 && !stop_flag)
+        {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed >= total)
+            {
+                break;
+            }
+            if (elapsed < spin)
+            {
+                for (size_t i = 0; i != SPIN_BATCH; i++)
+                {
+                    cpu_relax();
+                }
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        // 先退出自旋再加锁检查队列, 与 post 配合避免丢失唤醒
+        spinning_threads--;
+        return true;
+    }
 
-    void worker_thread()
+    // park until a task is queued, false if keep_alive ran out,
+    // caller holds queue_mutex
+    bool park(std::unique_lock<std::mutex>& lock)
     {
+        auto ready = [this]() { return stop_flag || queued != 0; };
+
+        // 不会被回收的线程无需定时醒来
+        if (workers.size() <= min_threads)
+        {
+            condition.wait(lock, ready);
+            return true;
+        }
+        return condition.wait_for(lock, keep_alive, ready);
+    }
+
+    void worker_thread(size_t id)
+    {
+        current_pool() = this;
+
+        std::vector<size_t> cpus;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            cpus = cpu_affinity;
+        }
+        if (!cpus.empty())
+        {
+            pin_current_thread(cpus);
+        }
+
         while (true)
         {
             Task task;
+            bool grown{false};
+            idle_threads++;
+            bool spun = spin_wait();
             {
                 std::unique_lock<std::mutex> lock(queue_mutex);
-                idle_threads++;
 
-                if (!condition.wait_for(
-                        lock, std::chrono::seconds(10),
-                        [this]() { return stop_flag || !tasks.empty(); }))
+                if (!park(lock))
                 {
                     idle_threads--;
                     if (workers.size() > min_threads)
                     {
+                        retire_worker(id);
+                        lock.unlock();
+                        notify_scaling(ScalingEvent::Shrink);
                         return;
                     }
 
@@ -107,27 +728,89 @@ private:
 
                 idle_threads--;
 
-                if (stop_flag && tasks.empty())
+                if (stop_flag && queued == 0)
                 {
                     return;
                 }
 
-                task = std::move(tasks.front());
-                tasks.pop();
+                auto now = std::chrono::steady_clock::now();
+                auto& lane = lanes[pick_lane(now)];
+                auto waited = now - lane.front().enqueued;
+                task = std::move(lane.front().task);
+                lane.pop();
+                queued--;
+
+                if (max_queue != 0)
+                {
+                    not_full.notify_one();
+                }
+
+                // post 见到自旋线程时未唤醒, 剩余任务交给休眠的线程
+                if (spun && queued != 0)
+                {
+                    condition.notify_one();
+                }
+
+                // 任务排队过久且没有空闲线程时扩容
+                if (queued != 0 && idle_threads == 0 && waited > grow_wait)
+                {
+                    grown = spawn_worker();
+                }
             }
 
-            task();
+            if (grown)
+            {
+                notify_scaling(ScalingEvent::Grow);
+            }
+            // submit 的异常已存入 future, 到这里的只有 post 的任务,
+            // 无人接收, 只计数, 工作线程继续取下一个任务
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                failed_count++;
+            }
+            completed_count++;
         }
     }
 
-    std::vector<std::thread> workers;
-    std::queue<Task> tasks;
+    std::unordered_map<size_t, std::thread> workers;
+    std::vector<std::thread> retired;
+
+    std::array<std::queue<QueuedTask>, LANES> lanes;
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> max_queue{0};
+    QueueFullPolicy full_policy{QueueFullPolicy::Reject};
 
     std::mutex queue_mutex;
     std::condition_variable condition;
+    std::condition_variable not_full;
 
     std::atomic<bool> stop_flag;
     std::atomic<size_t> idle_threads{0};
+    std::atomic<size_t> spinning_threads{0};
+    std::atomic<size_t> thread_count{0};
+    std::atomic<size_t> grow_count{0};
+    std::atomic<size_t> shrink_count{0};
+    std::atomic<size_t> completed_count{0};
+    std::atomic<size_t> failed_count{0};
+    std::atomic<size_t> rejected_count{0};
+    std::atomic<size_t> dropped_count{0};
+    std::atomic<size_t> caller_run_count{0};
+    std::atomic<size_t> blocked_count{0};
+    size_t next_worker_id{0};
     const size_t min_threads;
     const size_t max_threads;
+
+    std::chrono::milliseconds keep_alive{10000};
+    std::chrono::milliseconds grow_wait{10};
+    std::chrono::milliseconds aging{1000};
+    std::vector<size_t> cpu_affinity;
+    std::atomic<std::chrono::microseconds> spin_time{
+        std::chrono::microseconds(0)};
+    std::atomic<std::chrono::microseconds> yield_time{
+        std::chrono::microseconds(0)};
+    ScalingCallback scaling_callback;
 };
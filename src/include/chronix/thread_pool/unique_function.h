@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature>
+class unique_function;
+
+/*
+ * unique function
+ * Description: move-only std::function replacement,
+ *   callables up to BUFFER_SIZE bytes that move without throwing are stored
+ *   inline, larger ones on the heap, move-only captures are allowed
+ */
+template <typename R, typename... Args>
+class unique_function<R(Args...)>
+{
+public:
+    static constexpr size_t BUFFER_SIZE = 6 * sizeof(void*);
+
+    unique_function() noexcept = default;
+
+    unique_function(std::nullptr_t) noexcept {}
+
+    template <typename F,
+              typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<
+                  !std::is_same_v<Fn, unique_function> &&
+                  std::is_invocable_r_v<R, Fn&, Args...>>>
+    unique_function(F&& f)
+    {
+        if constexpr (is_local<Fn>)
+        {
+            ::new (static_cast<void*>(storage)) Fn(std::forward<F>(f));
+        }
+        else
+        {
+            *reinterpret_cast<Fn**>(storage) = new Fn(std::forward<F>(f));
+        }
+        vtable = &vtable_for<Fn>;
+    }
+
+    unique_function(unique_function&& other) noexcept
+    {
+        take(other);
+    }
+
+    unique_function& operator=(unique_function&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+
+    unique_function& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    unique_function(const unique_function&) = delete;
+    unique_function& operator=(const unique_function&) = delete;
+
+    ~unique_function()
+    {
+        reset();
+    }
+
+    R operator()(Args... args)
+    {
+        if (vtable == nullptr)
+        {
+            throw std::bad_function_call();
+        }
+        return vtable->invoke(storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return vtable != nullptr;
+    }
+
+private:
+    struct VTable
+    {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename Fn>
+    static constexpr bool is_local =
+        sizeof(Fn) <= BUFFER_SIZE &&
+        alignof(Fn) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<Fn>;
+
+    template <typename Fn>
+    static Fn* target(void* storage)
+    {
+        if constexpr (is_local<Fn>)
+        {
+            return std::launder(reinterpret_cast<Fn*>(storage));
+        }
+        else
+        {
+            return *reinterpret_cast<Fn**>(storage);
+        }
+    }
+
+    template <typename Fn>
+    static R invoke(void* storage, Args&&... args)
+    {
+        return std::invoke(*target<Fn>(storage), std::forward<Args>(args)...);
+    }
+
+    // 堆上对象只转移指针
+    template <typename Fn>
+    static void move(void* dst, void* src) noexcept
+    {
+        if constexpr (is_local<Fn>)
+        {
+            Fn* from = target<Fn>(src);
+            ::new (dst) Fn(std::move(*from));
+            from->~Fn();
+        }
+        else
+        {
+            *reinterpret_cast<Fn**>(dst) = *reinterpret_cast<Fn**>(src);
+        }
+    }
+
+    template <typename Fn>
+    static void destroy(void* storage) noexcept
+    {
+        if constexpr (is_local<Fn>)
+        {
+            target<Fn>(storage)->~Fn();
+        }
+        else
+        {
+            delete target<Fn>(storage);
+        }
+    }
+
+    template <typename Fn>
+    static constexpr VTable vtable_for{&invoke<Fn>, &move<Fn>, &destroy<Fn>};
+
+    void take(unique_function& other) noexcept
+    {
+        if (other.vtable != nullptr)
+        {
+            other.vtable->move(storage, other.storage);
+            vtable = other.vtable;
+            other.vtable = nullptr;
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (vtable != nullptr)
+        {
+            vtable->destroy(storage);
+            vtable = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage[BUFFER_SIZE];
+    const VTable* vtable{nullptr};
+};
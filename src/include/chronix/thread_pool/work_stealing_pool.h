@@ -0,0 +1,465 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "chronix/thread_pool/executor.h"
+
+/*
+ * work stealing deque
+ * Description: Chase-Lev deque, the owner pushes and pops at the bottom
+ *              without locks, other workers steal from the top
+ */
+template <typename T>
+class WorkStealingDeque
+{
+public:
+    // capacity must be a power of two
+    explicit WorkStealingDeque(size_t capacity = 1024)
+        : buffer(new Buffer(capacity))
+    {
+        buffers.emplace_back(buffer.load(std::memory_order_relaxed));
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // owner only
+    void push(T* item)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+
+        if (b - t > static_cast<int64_t>(a->capacity) - 1)
+        {
+            a = grow(a, b, t);
+        }
+
+        a->put(b, item);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    // owner only, nullptr if empty
+    T* pop()
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_seq_cst);
+
+        if (t > b)
+        {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* item = a->get(b);
+        if (t == b)
+        {
+            // 最后一个元素, 与窃取者竞争
+            if (!top.compare_exchange_strong(t, t + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed))
+            {
+                item = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // any thread, nullptr if empty or lost the race
+    T* steal()
+    {
+        int64_t t = top.load(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_seq_cst);
+
+        if (t >= b)
+        {
+            return nullptr;
+        }
+
+        Buffer* a = buffer.load(std::memory_order_acquire);
+        T* item = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return item;
+    }
+
+    bool empty() const
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return b <= t;
+    }
+
+private:
+    struct Buffer
+    {
+        explicit Buffer(size_t capacity)
+            : capacity(capacity), items(new std::atomic<T*>[capacity])
+        {}
+
+        T* get(int64_t index) const
+        {
+            return items[index & (capacity - 1)].load(
+                std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T* item)
+        {
+            items[index & (capacity - 1)].store(item,
+                                                std::memory_order_relaxed);
+        }
+
+        const size_t capacity;
+        std::unique_ptr<std::atomic<T*>[]> items;
+    };
+
+    // 旧缓冲区可能仍被窃取者读取, 析构时统一释放
+    Buffer* grow(Buffer* old, int64_t b, int64_t t)
+    {
+        auto* bigger = new Buffer(old->capacity * 2);
+        for (int64_t i = t; i != b; i++)
+        {
+            bigger->put(i, old->get(i));
+        }
+        buffers.emplace_back(bigger);
+        buffer.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    std::atomic<int64_t> top{0};
+    std::atomic<int64_t> bottom{0};
+    std::atomic<Buffer*> buffer;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+};
+
+/*
+ * work stealing pool
+ * Description: one lock-free deque per worker plus a global injection queue,
+ *   tasks posted by a worker stay on its own deque,
+ *   tasks posted from outside go through the injection queue,
+ *   idle workers steal from the others before parking,
+ *   task nodes are recycled through free lists, posts allocate nothing
+ *   once the pool has seen its peak backlog
+ */
+class WorkStealingPool : public Executor
+{
+public:
+    explicit WorkStealingPool(
+        size_t threads = std::thread::hardware_concurrency())
+    {
+        if (threads == 0)
+        {
+            throw std::runtime_error("threads == 0");
+        }
+
+        for (size_t i = 0; i != threads; i++)
+        {
+            queues.emplace_back(std::make_unique<WorkStealingDeque<Node>>());
+        }
+        caches = std::vector<NodeCache>(threads);
+        for (size_t i = 0; i != threads; i++)
+        {
+            workers.emplace_back(&WorkStealingPool::worker_thread, this, i);
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    using Executor::post;
+
+    void post(unique_function<void()> task) override
+    {
+        // 停止后工作线程仍可派生子任务, 排空后才退出
+        if (stop_flag && current_pool() != this)
+        {
+            throw std::runtime_error("post on stopped WorkStealingPool");
+        }
+
+        // 先计数再入队, 工作线程看到任务前不会计数下溢
+        pending.fetch_add(1);
+
+        // 入队失败时撤销计数, 否则工作线程永远不会休眠, 析构无法返回
+        Node* node = nullptr;
+        try
+        {
+            if (current_pool() == this)
+            {
+                auto& cache = caches[current_index()];
+                cache.size -= cache.head != nullptr;
+                node = pop_node(cache.head);
+                node->task = std::move(task);
+                queues[current_index()]->push(node);
+            }
+            else
+            {
+                std::lock_guard<std::mutex> lock(inject_mutex);
+                node = pop_node(shared_nodes);
+                node->task = std::move(task);
+                injected.emplace_back(node);
+            }
+        }
+        catch (...)
+        {
+            pending.fetch_sub(1);
+            delete node;
+            throw;
+        }
+
+        if (idle_threads.load() != 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(park_mutex);
+            }
+            park_cv.notify_one();
+        }
+    }
+
+    size_t get_thread_count() const override
+    {
+        return workers.size();
+    }
+
+    ExecutorMetrics get_metrics() const override
+    {
+        ExecutorMetrics metrics;
+        metrics.threads = workers.size();
+        metrics.active_threads =
+            metrics.threads - std::min(metrics.threads, idle_threads.load());
+        metrics.queued = pending;
+        metrics.completed = completed_count;
+        metrics.failed = failed_count;
+        return metrics;
+    }
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(park_mutex);
+            stop_flag = true;
+        }
+        park_cv.notify_all();
+
+        for (auto& worker : workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+
+        // 工作线程退出前已排空, 全部节点都在空闲链表中
+        for (auto& cache : caches)
+        {
+            free_nodes(cache.head);
+        }
+        free_nodes(shared_nodes);
+    }
+
+private:
+    using Task = unique_function<void()>;
+
+    // task stored by value, reused after it runs
+    struct Node
+    {
+        Task task;
+        Node* next{nullptr};
+    };
+
+    // free nodes of one worker, only that worker touches it
+    struct alignas(64) NodeCache
+    {
+        Node* head{nullptr};
+        size_t size{0};
+    };
+
+    static constexpr size_t INJECT_BATCH = 16;
+    static constexpr size_t NODE_CACHE = 256;
+
+    static WorkStealingPool*& current_pool()
+    {
+        static thread_local WorkStealingPool* pool{nullptr};
+        return pool;
+    }
+
+    static size_t& current_index()
+    {
+        static thread_local size_t index{0};
+        return index;
+    }
+
+    void worker_thread(size_t index)
+    {
+        current_pool() = this;
+        current_index() = index;
+
+        uint64_t seed = index * 0x9E3779B97F4A7C15ULL + 1;
+        while (true)
+        {
+            Node* node = queues[index]->pop();
+            if (node == nullptr)
+            {
+                node = pop_injected(index);
+            }
+            if (node == nullptr)
+            {
+                node = steal(index, seed);
+            }
+
+            if (node != nullptr)
+            {
+                pending.fetch_sub(1);
+                // 抛出的任务照常回收节点, 否则 pending 已减而节点泄漏
+                try
+                {
+                    node->task();
+                }
+                catch (...)
+                {
+                    failed_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                recycle(index, node);
+                completed_count.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // 先登记空闲再检查待执行数, 与 post 配合避免丢失唤醒
+            std::unique_lock<std::mutex> lock(park_mutex);
+            idle_threads.fetch_add(1);
+            park_cv.wait(lock, [this]() {
+                return stop_flag || pending.load() != 0;
+            });
+            idle_threads.fetch_sub(1);
+
+            if (stop_flag && pending.load() == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    // a free node from a list, a new one if the list is empty
+    static Node* pop_node(Node*& head)
+    {
+        if (head == nullptr)
+        {
+            return new Node;
+        }
+        return std::exchange(head, head->next);
+    }
+
+    static void free_nodes(Node* head)
+    {
+        while (head != nullptr)
+        {
+            delete std::exchange(head, head->next);
+        }
+    }
+
+    // 执行者与投递者常常不是同一线程, 本地链表过长时归还一半给外部投递
+    void recycle(size_t index, Node* node)
+    {
+        node->task = nullptr;
+
+        auto& cache = caches[index];
+        node->next = cache.head;
+        cache.head = node;
+        if (++cache.size <= NODE_CACHE)
+        {
+            return;
+        }
+
+        Node* first = cache.head;
+        Node* last = first;
+        for (size_t i = 1; i != NODE_CACHE / 2; i++)
+        {
+            last = last->next;
+        }
+        cache.head = last->next;
+        cache.size -= NODE_CACHE / 2;
+
+        std::lock_guard<std::mutex> lock(inject_mutex);
+        last->next = shared_nodes;
+        shared_nodes = first;
+    }
+
+    // 一次取出一批, 多余的放入本地队列供其他线程窃取
+    Node* pop_injected(size_t index)
+    {
+        std::lock_guard<std::mutex> lock(inject_mutex);
+        if (injected.empty())
+        {
+            return nullptr;
+        }
+
+        Node* node = injected.front();
+        injected.pop_front();
+
+        size_t batch = std::min(injected.size(), INJECT_BATCH);
+        for (size_t i = 0; i != batch; i++)
+        {
+            queues[index]->push(injected.front());
+            injected.pop_front();
+        }
+        return node;
+    }
+
+    // 从随机位置开始轮询其他工作线程
+    Node* steal(size_t index, uint64_t& seed)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        size_t count = queues.size();
+        size_t start = seed % count;
+        for (size_t i = 0; i != count; i++)
+        {
+            size_t victim = (start + i) % count;
+            if (victim == index)
+            {
+                continue;
+            }
+            if (Node* node = queues[victim]->steal())
+            {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<std::unique_ptr<WorkStealingDeque<Node>>> queues;
+    std::vector<std::thread> workers;
+    std::vector<NodeCache> caches;
+
+    // injected 与 shared_nodes 都由 inject_mutex 保护
+    std::deque<Node*> injected;
+    Node* shared_nodes{nullptr};
+    std::mutex inject_mutex;
+
+    std::mutex park_mutex;
+    std::condition_variable park_cv;
+
+    std::atomic<bool> stop_flag{false};
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> idle_threads{0};
+    std::atomic<size_t> completed_count{0};
+    std::atomic<size_t> failed_count{0};
+};
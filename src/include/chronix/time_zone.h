@@ -0,0 +1,681 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "chronix/croncpp.h"
+
+/*
+ * time zone
+ * Description: UTC offsets of one zone, loaded once from a TZif file of
+ *   the zoneinfo database or from a POSIX TZ rule, immutable afterwards
+ *   so conversions take no lock and never touch localtime or mktime
+ */
+class TimeZone
+{
+public:
+    // zone by IANA name such as "Asia/Shanghai", loaded once and shared,
+    // throws if no zoneinfo file or POSIX rule matches
+    static std::shared_ptr<const TimeZone> locate(const std::string& name)
+    {
+        if (name.empty() || name == "UTC" || name == "Etc/UTC")
+        {
+            return utc();
+        }
+
+        auto& registry = zones();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.loaded.find(name);
+        if (it != registry.loaded.end())
+        {
+            return it->second;
+        }
+
+        auto zone = load(name);
+        if (!zone)
+        {
+            throw std::runtime_error("Unknown time zone: " + name);
+        }
+        registry.loaded.emplace(name, zone);
+        return zone;
+    }
+
+    static std::shared_ptr<const TimeZone> utc()
+    {
+        static const std::shared_ptr<const TimeZone> zone =
+            from_posix("UTC", "UTC0");
+        return zone;
+    }
+
+    // zone of the process, from TZ or /etc/localtime, libc conversions
+    // are kept only where neither can be read
+    static std::shared_ptr<const TimeZone> local()
+    {
+        static const std::shared_ptr<const TimeZone> zone = load_local();
+        return zone;
+    }
+
+    // zone from raw TZif bytes
+    static std::shared_ptr<const TimeZone> from_tzif(const std::string& name,
+                                                     const std::string& data)
+    {
+        std::shared_ptr<TimeZone> zone(new TimeZone(name));
+        if (!zone->parse_tzif(data))
+        {
+            throw std::runtime_error("Invalid TZif data: " + name);
+        }
+        return zone;
+    }
+
+    // zone from a POSIX TZ rule such as "CET-1CEST,M3.5.0,M10.5.0/3"
+    static std::shared_ptr<const TimeZone> from_posix(const std::string& name,
+                                                      const std::string& spec)
+    {
+        std::shared_ptr<TimeZone> zone(new TimeZone(name));
+        if (!parse_rule(spec, zone->rule))
+        {
+            throw std::runtime_error("Invalid TZ rule: " + spec);
+        }
+        zone->has_rule = true;
+        return zone;
+    }
+
+    const std::string& name() const
+    {
+        return zone_name;
+    }
+
+    // seconds east of UTC in effect at a UTC instant
+    int32_t offset_at(int64_t utc) const
+    {
+        if (system)
+        {
+            return system_offset(utc);
+        }
+
+        // 首次切换之前使用 0 号类型, 最后一次切换之后使用尾部规则
+        if (!times.empty() && utc < times.front())
+        {
+            return types[0].offset;
+        }
+        if (has_rule && (times.empty() || utc >= times.back()))
+        {
+            return rule_offset(utc);
+        }
+        if (times.empty())
+        {
+            return types.empty() ? 0 : types[0].offset;
+        }
+
+        auto it = std::upper_bound(times.begin(), times.end(), utc);
+        return types[type_indexes[it - times.begin() - 1]].offset;
+    }
+
+    // wall clock seconds since the epoch of a UTC instant
+    int64_t to_local(int64_t utc) const
+    {
+        return utc + offset_at(utc);
+    }
+
+    // UTC instant of a wall clock time, the first of a repeated hour or
+    // the second if later is set, a skipped time is moved forward by the
+    // length of the gap (02:30 in a one hour gap resolves to 03:30)
+    int64_t to_utc(int64_t local, bool later = false) const
+    {
+        if (system)
+        {
+            return system_to_utc(local, later);
+        }
+
+        // 一天内最多一次切换, 前后各取一天的偏移作为候选
+        int32_t before = offset_at(local - 86400);
+        int32_t after = offset_at(local + 86400);
+        int64_t early = local - before;
+        int64_t late = local - after;
+        bool early_valid = offset_at(early) == before;
+        bool late_valid = offset_at(late) == after;
+
+        if (early_valid && late_valid)
+        {
+            return later ? std::max(early, late) : std::min(early, late);
+        }
+        if (late_valid)
+        {
+            return late;
+        }
+        return early;
+    }
+
+private:
+    struct LocalType
+    {
+        int32_t offset;
+        bool dst;
+    };
+
+    // one end of daylight saving time in a POSIX TZ rule
+    struct RuleDate
+    {
+        enum class Kind
+        {
+            Julian,
+            ZeroBased,
+            MonthWeekDay
+        };
+
+        Kind kind{Kind::MonthWeekDay};
+        int day{0};
+        int week{0};
+        int month{0};
+        int32_t time{7200};
+    };
+
+    struct Rule
+    {
+        int32_t std_offset{0};
+        int32_t dst_offset{0};
+        bool has_dst{false};
+        RuleDate start;
+        RuleDate end;
+    };
+
+    struct Registry
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<const TimeZone>>
+            loaded;
+    };
+
+    explicit TimeZone(std::string name) : zone_name(std::move(name)) {}
+
+    static Registry& zones()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    static std::string zoneinfo_dir()
+    {
+        const char* dir = std::getenv("TZDIR");
+        return dir && *dir ? dir : "/usr/share/zoneinfo";
+    }
+
+    static bool read_file(const std::string& path, std::string& data)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        data.assign(std::istreambuf_iterator<char>(file),
+                    std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    static std::shared_ptr<TimeZone> load(const std::string& name)
+    {
+        std::shared_ptr<TimeZone> zone(new TimeZone(name));
+
+        // 名字不能跳出 zoneinfo 目录
+        std::string data;
+        if (name.find("..") == std::string::npos && name.front() != '/' &&
+            read_file(zoneinfo_dir() + "/" + name, data) &&
+            zone->parse_tzif(data))
+        {
+            return zone;
+        }
+
+        if (parse_rule(name, zone->rule))
+        {
+            zone->has_rule = true;
+            return zone;
+        }
+        return nullptr;
+    }
+
+    static std::shared_ptr<const TimeZone> load_local()
+    {
+        const char* tz = std::getenv("TZ");
+        if (tz != nullptr)
+        {
+            std::string name = tz;
+            if (!name.empty() && name.front() == ':')
+            {
+                name.erase(0, 1);
+            }
+            if (name.empty())
+            {
+                return utc();
+            }
+
+            std::string data;
+            std::shared_ptr<TimeZone> zone(new TimeZone(name));
+            if (name.front() == '/' && read_file(name, data) &&
+                zone->parse_tzif(data))
+            {
+                return zone;
+            }
+            try
+            {
+                return locate(name);
+            }
+            catch (const std::exception&)
+            {
+            }
+        }
+        else
+        {
+            std::string data;
+            std::shared_ptr<TimeZone> zone(new TimeZone("localtime"));
+            if (read_file("/etc/localtime", data) && zone->parse_tzif(data))
+            {
+                return zone;
+            }
+        }
+
+        std::shared_ptr<TimeZone> zone(new TimeZone("localtime"));
+        zone->system = true;
+        return zone;
+    }
+
+    static int64_t read_be(const std::string& data, size_t pos, size_t size)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i != size; i++)
+        {
+            value = value << 8 | static_cast<unsigned char>(data[pos + i]);
+        }
+        // 按位宽做符号扩展
+        if (size < 8 && (value >> (size * 8 - 1)) != 0)
+        {
+            value |= ~uint64_t{0} << (size * 8);
+        }
+        return static_cast<int64_t>(value);
+    }
+
+    // RFC 8536, version 2 and later use the 64-bit block and the footer,
+    // leap second records are skipped, times stay POSIX seconds
+    bool parse_tzif(const std::string& data)
+    {
+        const size_t header_size = 44;
+        if (data.size() < header_size || data.compare(0, 4, "TZif") != 0)
+        {
+            return false;
+        }
+
+        size_t pos = 0;
+        bool wide = false;
+        for (;;)
+        {
+            if (data.size() < pos + header_size ||
+                data.compare(pos, 4, "TZif") != 0)
+            {
+                return false;
+            }
+
+            char version = data[pos + 4];
+            auto count = [&](size_t index) {
+                return static_cast<size_t>(
+                    read_be(data, pos + 20 + index * 4, 4) & 0xFFFFFFFF);
+            };
+            size_t isutcnt = count(0);
+            size_t isstdcnt = count(1);
+            size_t leapcnt = count(2);
+            size_t timecnt = count(3);
+            size_t typecnt = count(4);
+            size_t charcnt = count(5);
+            size_t time_size = wide ? 8 : 4;
+
+            size_t body = pos + header_size;
+            size_t body_size = timecnt * time_size + timecnt + typecnt * 6 +
+                               charcnt + leapcnt * (time_size + 4) +
+                               isstdcnt + isutcnt;
+            if (typecnt == 0 || data.size() < body + body_size)
+            {
+                return false;
+            }
+
+            // 第 2 版起跳过 32 位数据块
+            if (!wide && version >= '2')
+            {
+                pos = body + body_size;
+                wide = true;
+                continue;
+            }
+
+            times.clear();
+            type_indexes.clear();
+            types.clear();
+            for (size_t i = 0; i != timecnt; i++)
+            {
+                times.emplace_back(
+                    read_be(data, body + i * time_size, time_size));
+            }
+            size_t index_pos = body + timecnt * time_size;
+            for (size_t i = 0; i != timecnt; i++)
+            {
+                auto index = static_cast<unsigned char>(data[index_pos + i]);
+                if (index >= typecnt)
+                {
+                    return false;
+                }
+                type_indexes.emplace_back(index);
+            }
+            size_t type_pos = index_pos + timecnt;
+            for (size_t i = 0; i != typecnt; i++)
+            {
+                types.push_back(
+                    LocalType{static_cast<int32_t>(
+                                  read_be(data, type_pos + i * 6, 4)),
+                              data[type_pos + i * 6 + 4] != 0});
+            }
+            if (!std::is_sorted(times.begin(), times.end()))
+            {
+                return false;
+            }
+
+            size_t footer = body + body_size;
+            if (wide && footer < data.size() && data[footer] == '\n')
+            {
+                size_t end = data.find('\n', footer + 1);
+                if (end != std::string::npos && end > footer + 1)
+                {
+                    has_rule = parse_rule(
+                        data.substr(footer + 1, end - footer - 1), rule);
+                }
+            }
+            return true;
+        }
+    }
+
+    static bool parse_name(const std::string& spec, size_t& pos)
+    {
+        size_t start = pos;
+        if (pos < spec.size() && spec[pos] == '<')
+        {
+            size_t end = spec.find('>', pos);
+            if (end == std::string::npos)
+            {
+                return false;
+            }
+            pos = end + 1;
+            return end - start > 1;
+        }
+        while (pos < spec.size() &&
+               std::isalpha(static_cast<unsigned char>(spec[pos])))
+        {
+            pos++;
+        }
+        return pos - start >= 3;
+    }
+
+    // [+-]hh[:mm[:ss]], false if no digit is found
+    static bool parse_time(const std::string& spec, size_t& pos,
+                           int32_t& seconds, int max_hours)
+    {
+        int sign = 1;
+        if (pos < spec.size() && (spec[pos] == '+' || spec[pos] == '-'))
+        {
+            sign = spec[pos] == '-' ? -1 : 1;
+            pos++;
+        }
+
+        int32_t parts[3] = {0, 0, 0};
+        for (int part = 0; part != 3; part++)
+        {
+            if (part != 0)
+            {
+                if (pos >= spec.size() || spec[pos] != ':')
+                {
+                    break;
+                }
+                pos++;
+            }
+            size_t start = pos;
+            while (pos < spec.size() &&
+                   std::isdigit(static_cast<unsigned char>(spec[pos])) &&
+                   pos - start < 3)
+            {
+                parts[part] = parts[part] * 10 + (spec[pos] - '0');
+                pos++;
+            }
+            if (pos == start)
+            {
+                return false;
+            }
+        }
+        if (parts[0] > max_hours || parts[1] > 59 || parts[2] > 59)
+        {
+            return false;
+        }
+
+        seconds = sign * (parts[0] * 3600 + parts[1] * 60 + parts[2]);
+        return true;
+    }
+
+    static bool parse_number(const std::string& spec, size_t& pos, int& value,
+                             int minimum, int maximum)
+    {
+        size_t start = pos;
+        value = 0;
+        while (pos < spec.size() &&
+               std::isdigit(static_cast<unsigned char>(spec[pos])) &&
+               pos - start < 3)
+        {
+            value = value * 10 + (spec[pos] - '0');
+            pos++;
+        }
+        return pos != start && value >= minimum && value <= maximum;
+    }
+
+    static bool parse_date(const std::string& spec, size_t& pos,
+                           RuleDate& date)
+    {
+        if (pos < spec.size() && spec[pos] == 'M')
+        {
+            pos++;
+            date.kind = RuleDate::Kind::MonthWeekDay;
+            if (!parse_number(spec, pos, date.month, 1, 12) ||
+                pos >= spec.size() || spec[pos++] != '.' ||
+                !parse_number(spec, pos, date.week, 1, 5) ||
+                pos >= spec.size() || spec[pos++] != '.' ||
+                !parse_number(spec, pos, date.day, 0, 6))
+            {
+                return false;
+            }
+        }
+        else if (pos < spec.size() && spec[pos] == 'J')
+        {
+            pos++;
+            date.kind = RuleDate::Kind::Julian;
+            if (!parse_number(spec, pos, date.day, 1, 365))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            date.kind = RuleDate::Kind::ZeroBased;
+            if (!parse_number(spec, pos, date.day, 0, 365))
+            {
+                return false;
+            }
+        }
+
+        date.time = 7200;
+        if (pos < spec.size() && spec[pos] == '/')
+        {
+            pos++;
+            // 第 3 版允许 -167 到 167 小时
+            return parse_time(spec, pos, date.time, 167);
+        }
+        return true;
+    }
+
+    // std offset [dst [offset] [,start[/time],end[/time]]]
+    static bool parse_rule(const std::string& spec, Rule& rule)
+    {
+        size_t pos = 0;
+        int32_t west{0};
+        if (!parse_name(spec, pos) || !parse_time(spec, pos, west, 24))
+        {
+            return false;
+        }
+        rule = Rule{};
+        rule.std_offset = -west;
+        rule.dst_offset = rule.std_offset;
+        if (pos == spec.size())
+        {
+            return true;
+        }
+
+        if (!parse_name(spec, pos))
+        {
+            return false;
+        }
+        rule.has_dst = true;
+        rule.dst_offset = rule.std_offset + 3600;
+        if (pos < spec.size() && spec[pos] != ',')
+        {
+            if (!parse_time(spec, pos, west, 24))
+            {
+                return false;
+            }
+            rule.dst_offset = -west;
+        }
+
+        // 未给出切换规则时沿用美国规则
+        if (pos == spec.size())
+        {
+            rule.start = RuleDate{RuleDate::Kind::MonthWeekDay, 0, 2, 3, 7200};
+            rule.end = RuleDate{RuleDate::Kind::MonthWeekDay, 0, 1, 11, 7200};
+            return true;
+        }
+
+        if (spec[pos++] != ',' || !parse_date(spec, pos, rule.start) ||
+            pos >= spec.size() || spec[pos++] != ',' ||
+            !parse_date(spec, pos, rule.end))
+        {
+            return false;
+        }
+        return pos == spec.size();
+    }
+
+    // local seconds since the epoch at which date falls in year
+    static int64_t rule_local_time(const RuleDate& date, int64_t year)
+    {
+        using cron::detail::days_from_civil;
+        using cron::detail::days_in_month;
+        using cron::detail::weekday_from_days;
+
+        int64_t days{0};
+        bool leap = days_in_month(year, 2) == 29;
+        switch (date.kind)
+        {
+        case RuleDate::Kind::Julian:
+            days = days_from_civil(year, 1, 1) + date.day - 1 +
+                   (leap && date.day >= 60 ? 1 : 0);
+            break;
+        case RuleDate::Kind::ZeroBased:
+            days = days_from_civil(year, 1, 1) + date.day;
+            break;
+        case RuleDate::Kind::MonthWeekDay:
+        {
+            int64_t first = days_from_civil(year, date.month, 1);
+            unsigned weekday = weekday_from_days(first);
+            int64_t day =
+                (date.day - static_cast<int>(weekday) + 7) % 7 +
+                (date.week - 1) * 7;
+            // 第 5 周表示当月最后一个
+            while (day >= days_in_month(year, date.month))
+            {
+                day -= 7;
+            }
+            days = first + day;
+            break;
+        }
+        }
+        return days * 86400 + date.time;
+    }
+
+    int32_t rule_offset(int64_t utc) const
+    {
+        if (!rule.has_dst)
+        {
+            return rule.std_offset;
+        }
+
+        int64_t year = cron::detail::civil_from_seconds(utc + rule.std_offset)
+                           .year;
+        int64_t start = rule_local_time(rule.start, year) - rule.std_offset;
+        int64_t end = rule_local_time(rule.end, year) - rule.dst_offset;
+        // 南半球夏令时跨年
+        bool dst = start < end ? utc >= start && utc < end
+                               : utc >= start || utc < end;
+        return dst ? rule.dst_offset : rule.std_offset;
+    }
+
+    static int32_t system_offset(int64_t utc)
+    {
+        std::time_t time = static_cast<std::time_t>(utc);
+        std::tm date;
+        if (cron::utils::time_to_tm(&time, &date) == nullptr)
+        {
+            return 0;
+        }
+        cron::detail::civil_time civil{
+            date.tm_year + 1900, static_cast<unsigned>(date.tm_mon + 1),
+            static_cast<unsigned>(date.tm_mday),
+            static_cast<unsigned>(date.tm_hour),
+            static_cast<unsigned>(date.tm_min),
+            static_cast<unsigned>(date.tm_sec)};
+        return static_cast<int32_t>(cron::detail::civil_to_seconds(civil) -
+                                    utc);
+    }
+
+    static int64_t system_to_utc(int64_t local, bool later)
+    {
+        auto civil = cron::detail::civil_from_seconds(local);
+        std::tm date{};
+        date.tm_year = static_cast<int>(civil.year - 1900);
+        date.tm_mon = static_cast<int>(civil.month - 1);
+        date.tm_mday = static_cast<int>(civil.day);
+        date.tm_hour = static_cast<int>(civil.hour);
+        date.tm_min = static_cast<int>(civil.minute);
+        date.tm_sec = static_cast<int>(civil.second);
+        date.tm_isdst = -1;
+        std::tm standard = date;
+        int64_t utc = cron::utils::tm_to_time(date);
+
+        // 重复的一小时里按标准时间再换算一次得到较晚的时刻
+        if (later)
+        {
+            standard.tm_isdst = 0;
+            int64_t late = cron::utils::tm_to_time(standard);
+            if (late > utc && late + system_offset(late) == local)
+            {
+                return late;
+            }
+        }
+        return utc;
+    }
+
+    std::string zone_name;
+    std::vector<int64_t> times;
+    std::vector<uint8_t> type_indexes;
+    std::vector<LocalType> types;
+    Rule rule;
+    bool has_rule{false};
+    bool system{false};
+};
@@ -1,5 +1,43 @@
 #include "config/config.h"
 
+static JobPriority parse_priority(const std::string& priority)
+{
+    if (priority == "low")
+    {
+        return JobPriority::Low;
+    }
+    if (priority == "normal")
+    {
+        return JobPriority::Normal;
+    }
+    if (priority == "high")
+    {
+        return JobPriority::High;
+    }
+    throw std::runtime_error("Invalid priority: " + priority);
+}
+
+static QueueFullPolicy parse_full_policy(const std::string& policy)
+{
+    if (policy == "block")
+    {
+        return QueueFullPolicy::Block;
+    }
+    if (policy == "reject")
+    {
+        return QueueFullPolicy::Reject;
+    }
+    if (policy == "drop_oldest")
+    {
+        return QueueFullPolicy::DropOldest;
+    }
+    if (policy == "caller_runs")
+    {
+        return QueueFullPolicy::CallerRuns;
+    }
+    throw std::runtime_error("Invalid queue full policy: " + policy);
+}
+
 ServerConfig::ServerConfig(const std::string& filepath)
 {
     std::ifstream fp(filepath);
@@ -19,6 +57,87 @@ ServerConfig::ServerConfig(const std::string& filepath)
             node["chronix"]["thread_pool"]["min_threads"].as<size_t>();
         chronix_config.thread_pool_config.max_threads =
             node["chronix"]["thread_pool"]["max_threads"].as<size_t>();
+
+        // 可选配置, 缺省时使用默认值
+        auto thread_pool = node["chronix"]["thread_pool"];
+        if (thread_pool["aging_ms"])
+        {
+            chronix_config.thread_pool_config.aging_ms =
+                thread_pool["aging_ms"].as<size_t>();
+        }
+        if (thread_pool["max_queue"])
+        {
+            chronix_config.thread_pool_config.max_queue =
+                thread_pool["max_queue"].as<size_t>();
+        }
+        if (thread_pool["full_policy"])
+        {
+            chronix_config.thread_pool_config.full_policy = parse_full_policy(
+                thread_pool["full_policy"].as<std::string>());
+        }
+        if (thread_pool["spin_us"])
+        {
+            chronix_config.thread_pool_config.spin_us =
+                thread_pool["spin_us"].as<size_t>();
+        }
+        if (thread_pool["yield_us"])
+        {
+            chronix_config.thread_pool_config.yield_us =
+                thread_pool["yield_us"].as<size_t>();
+        }
+        if (thread_pool["dispatcher_cpu"])
+        {
+            chronix_config.thread_pool_config.dispatcher_cpu =
+                thread_pool["dispatcher_cpu"].as<size_t>();
+        }
+        if (thread_pool["cpus"])
+        {
+            chronix_config.thread_pool_config.cpus =
+                parse_cpu_list(thread_pool["cpus"].as<std::string>());
+        }
+        if (thread_pool["numa"])
+        {
+            chronix_config.thread_pool_config.numa =
+                thread_pool["numa"].as<bool>();
+        }
+
+        auto& priority_config = chronix_config.priority_config;
+        if (auto priority = node["chronix"]["priority"])
+        {
+            if (priority["cron"])
+            {
+                priority_config.cron =
+                    parse_priority(priority["cron"].as<std::string>());
+            }
+            if (priority["once"])
+            {
+                priority_config.once =
+                    parse_priority(priority["once"].as<std::string>());
+            }
+            if (priority["immediate"])
+            {
+                priority_config.immediate =
+                    parse_priority(priority["immediate"].as<std::string>());
+            }
+        }
+
+        for (const auto& pool : node["chronix"]["pools"])
+        {
+            ChronixPoolConfig pool_config;
+            pool_config.name = pool["name"].as<std::string>();
+            pool_config.min_threads = pool["min_threads"].as<size_t>();
+            pool_config.max_threads = pool["max_threads"].as<size_t>();
+            if (pool["max_queue"])
+            {
+                pool_config.max_queue = pool["max_queue"].as<size_t>();
+            }
+            if (pool["full_policy"])
+            {
+                pool_config.full_policy =
+                    parse_full_policy(pool["full_policy"].as<std::string>());
+            }
+            chronix_config.pools.emplace_back(std::move(pool_config));
+        }
     }
     catch (const YAML::Exception& e)
     {
@@ -42,6 +161,11 @@ int ServerConfig::get_port() const
     return port;
 }
 
+std::string ServerConfig::get_time_location() const
+{
+    return time_location;
+}
+
 size_t ServerConfig::get_min_threads() const
 {
     return chronix_config.thread_pool_config.min_threads;
@@ -51,3 +175,60 @@ size_t ServerConfig::get_max_threads() const
 {
     return chronix_config.thread_pool_config.max_threads;
 }
+
+size_t ServerConfig::get_aging_ms() const
+{
+    return chronix_config.thread_pool_config.aging_ms;
+}
+
+size_t ServerConfig::get_max_queue() const
+{
+    return chronix_config.thread_pool_config.max_queue;
+}
+
+QueueFullPolicy ServerConfig::get_full_policy() const
+{
+    return chronix_config.thread_pool_config.full_policy;
+}
+
+WorkerWait ServerConfig::get_worker_wait() const
+{
+    return WorkerWait{
+        std::chrono::microseconds(chronix_config.thread_pool_config.spin_us),
+        std::chrono::microseconds(chronix_config.thread_pool_config.yield_us)};
+}
+
+std::optional<size_t> ServerConfig::get_dispatcher_cpu() const
+{
+    return chronix_config.thread_pool_config.dispatcher_cpu;
+}
+
+const std::vector<size_t>& ServerConfig::get_cpus() const
+{
+    return chronix_config.thread_pool_config.cpus;
+}
+
+bool ServerConfig::get_numa() const
+{
+    return chronix_config.thread_pool_config.numa;
+}
+
+JobPriority ServerConfig::get_priority(JobType type) const
+{
+    switch (type)
+    {
+    case JobType::Cron:
+        return chronix_config.priority_config.cron;
+    case JobType::Once:
+        return chronix_config.priority_config.once;
+    case JobType::Immediate:
+        return chronix_config.priority_config.immediate;
+    }
+    return JobPriority::Normal;
+}
+
+const std::vector<ServerConfig::ChronixPoolConfig>& ServerConfig::get_pools()
+    const
+{
+    return chronix_config.pools;
+}
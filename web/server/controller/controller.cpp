@@ -9,7 +9,9 @@ void Controller::insert_cron_task(const httplib::Request& req,
         InsertCronTaskForm params = j.get<InsertCronTaskForm>();
 
         auto scheduler = get_initialize()->get_scheduler();
-        size_t id = scheduler->add_cron_job(params.cron, [params]() {
+        auto priority = get_initialize()->get_config()->get_priority(
+            JobType::Cron);
+        Task task = [params]() {
             auto [host, path] =
                 extract_host_and_path(force_http(params.callback_url));
             httplib::Client client(host);
@@ -31,7 +33,10 @@ void Controller::insert_cron_task(const httplib::Request& req,
                 std::clog << "[Info] callback response: " << result->body
                           << std::endl;
             }
-        });
+        };
+        size_t id =
+            scheduler->add_cron_job(params.cron, std::move(task), priority,
+                                    params.pool, params.time_zone);
 
         success(resp, id);
     }
@@ -52,8 +57,10 @@ void Controller::insert_once_task(const httplib::Request& req,
         auto tp = parse_iso_time(params.run_at);
 
         auto scheduler = get_initialize()->get_scheduler();
+        auto priority = get_initialize()->get_config()->get_priority(
+            JobType::Once);
 
-        size_t id = scheduler->add_once_job(tp, [params]() {
+        Task task = [params]() {
             auto [host, path] =
                 extract_host_and_path(force_http(params.callback_url));
 
@@ -76,7 +83,9 @@ void Controller::insert_once_task(const httplib::Request& req,
                 std::clog << "[Info] callback response: " << result->body
                           << std::endl;
             }
-        });
+        };
+        size_t id = scheduler->add_once_job(tp, std::move(task), priority,
+                                            params.pool);
         success(resp, id);
     }
     catch (const std::exception& e)
@@ -94,7 +103,9 @@ void Controller::insert_immediate_task(const httplib::Request& req,
         InsertImmediateTaskForm params = j.get<InsertImmediateTaskForm>();
 
         auto scheduler = get_initialize()->get_scheduler();
-        size_t id = scheduler->add_immediate_job([params]() {
+        auto priority = get_initialize()->get_config()->get_priority(
+            JobType::Immediate);
+        Task task = [params]() {
             auto [host, path] =
                 extract_host_and_path(force_http(params.callback_url));
 
@@ -117,7 +128,9 @@ void Controller::insert_immediate_task(const httplib::Request& req,
                 std::clog << "[Info] callback response: " << result->body
                           << std::endl;
             }
-        });
+        };
+        size_t id = scheduler->add_immediate_job(std::move(task), priority,
+                                                 params.pool);
 
         success(resp, id);
     }
@@ -446,6 +459,7 @@ void Controller::get_job_metrics(const httplib::Request& req,
             result.execution_count = metrics.execution_count;
             result.success_count = metrics.success_count;
             result.error_count = metrics.error_count;
+            result.misfire_count = metrics.misfire_count;
 
             result.last_run_time = to_iso_time(metrics.last_run_time);
             result.last_duration = metrics.last_duration.count();
@@ -505,6 +519,20 @@ void Controller::get_running_job_count(const httplib::Request& req,
     }
 }
 
+void Controller::get_paused_job_count(const httplib::Request& req,
+                                      httplib::Response& resp)
+{
+    try
+    {
+        auto scheduler = get_initialize()->get_scheduler();
+        success(resp, scheduler->get_paused_job_count());
+    }
+    catch (const std::exception& e)
+    {
+        error(resp, INTERNAL_SERVER_ERROR_CODE, e);
+    }
+}
+
 void Controller::get_running(const httplib::Request&, httplib::Response& resp)
 {
     try
@@ -518,6 +546,41 @@ void Controller::get_running(const httplib::Request&, httplib::Response& resp)
     }
 }
 
+void Controller::get_pool_metrics(const httplib::Request&,
+                                  httplib::Response& resp)
+{
+    try
+    {
+        auto scheduler = get_initialize()->get_scheduler();
+
+        std::vector<PoolMetrics> result;
+        for (const auto& name : scheduler->get_pool_names())
+        {
+            auto metrics = scheduler->get_pool_metrics(name);
+            result.push_back(PoolMetrics{
+                name,
+                metrics.threads,
+                metrics.active_threads,
+                metrics.queued,
+                metrics.max_queue,
+                metrics.completed,
+                metrics.failed,
+                metrics.rejected,
+                metrics.dropped,
+                metrics.caller_runs,
+                metrics.blocked,
+                metrics.utilization(),
+            });
+        }
+
+        success(resp, result);
+    }
+    catch (const std::exception& e)
+    {
+        error(resp, INTERNAL_SERVER_ERROR_CODE, e);
+    }
+}
+
 const std::shared_ptr<Initialize> Controller::get_initialize()
 {
     return initialize;
@@ -44,6 +44,54 @@ std::shared_ptr<ChronixScheduler> Initialize::init_chronix(const std::shared_ptr
     {
         scheduler = std::make_shared<ChronixScheduler>(
             server_config->get_min_threads(), server_config->get_max_threads());
+        // 未指定时区的 cron 任务按 time_location 计算
+        if (!server_config->get_time_location().empty())
+        {
+            scheduler->set_time_zone(server_config->get_time_location());
+        }
+
+        auto configure = [&](ThreadPool& pool) {
+            pool.set_aging(
+                std::chrono::milliseconds(server_config->get_aging_ms()));
+            pool.set_max_queue(server_config->get_max_queue(),
+                               server_config->get_full_policy());
+            pool.set_worker_wait(server_config->get_worker_wait());
+        };
+
+        // NUMA 模式下每个节点一个线程池, 否则整体绑定到 cpus
+        if (server_config->get_numa())
+        {
+            auto numa_pool = std::make_unique<NumaPool>(
+                server_config->get_min_threads(),
+                server_config->get_max_threads(), server_config->get_cpus());
+            for (size_t i = 0; i != numa_pool->get_node_count(); i++)
+            {
+                configure(numa_pool->get_node_pool(i));
+            }
+            scheduler->set_executor(std::move(numa_pool));
+        }
+        else
+        {
+            auto thread_pool = std::make_unique<ThreadPool>(
+                server_config->get_min_threads(),
+                server_config->get_max_threads());
+            configure(*thread_pool);
+            thread_pool->set_cpu_affinity(server_config->get_cpus());
+            scheduler->set_executor(std::move(thread_pool));
+        }
+
+        if (auto cpu = server_config->get_dispatcher_cpu())
+        {
+            scheduler->set_dispatcher_affinity({*cpu});
+        }
+
+        for (const auto& pool : server_config->get_pools())
+        {
+            scheduler->add_executor_pool(pool.name, pool.min_threads,
+                                         pool.max_threads, pool.max_queue,
+                                         pool.full_policy);
+        }
+
         scheduler->start();
 
         return scheduler;
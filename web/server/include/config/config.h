@@ -1,31 +1,71 @@
 #pragma once
 
 #include <fstream>
+#include <optional>
 #include <string>
+#include <vector>
 
+#include "chronix/define.h"
+#include "chronix/thread_pool/thread_pool.h"
 #include "yaml-cpp/yaml.h"
 
 class ServerConfig
 {
 public:
+    struct ChronixPoolConfig
+    {
+        std::string name;
+        size_t min_threads;
+        size_t max_threads;
+        size_t max_queue{0};
+        QueueFullPolicy full_policy{QueueFullPolicy::Reject};
+    };
+
     ServerConfig(const std::string& filepath);
 
     std::string get_name() const;
     std::string get_mode() const;
     int get_port() const;
+    std::string get_time_location() const;
     size_t get_min_threads() const;
     size_t get_max_threads() const;
+    size_t get_aging_ms() const;
+    size_t get_max_queue() const;
+    QueueFullPolicy get_full_policy() const;
+    WorkerWait get_worker_wait() const;
+    std::optional<size_t> get_dispatcher_cpu() const;
+    const std::vector<size_t>& get_cpus() const;
+    bool get_numa() const;
+    JobPriority get_priority(JobType type) const;
+    const std::vector<ChronixPoolConfig>& get_pools() const;
 
 private:
     struct ChronixThreadPoolConfig
     {
         size_t min_threads;
         size_t max_threads;
+        size_t aging_ms{1000};
+        size_t max_queue{0};
+        QueueFullPolicy full_policy{QueueFullPolicy::Block};
+        size_t spin_us{0};
+        size_t yield_us{0};
+        std::optional<size_t> dispatcher_cpu;
+        std::vector<size_t> cpus;
+        bool numa{false};
+    };
+
+    struct ChronixPriorityConfig
+    {
+        JobPriority cron{JobPriority::Normal};
+        JobPriority once{JobPriority::Normal};
+        JobPriority immediate{JobPriority::Normal};
     };
 
     struct ChronixConfig
     {
         ChronixThreadPoolConfig thread_pool_config;
+        ChronixPriorityConfig priority_config;
+        std::vector<ChronixPoolConfig> pools;
     };
 
     std::string name;
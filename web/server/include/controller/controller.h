@@ -38,7 +38,11 @@ public:
     void get_job_count(const httplib::Request& req, httplib::Response& resp);
     void get_running_job_count(const httplib::Request& req,
                                httplib::Response& resp);
+    void get_paused_job_count(const httplib::Request& req,
+                              httplib::Response& resp);
     void get_running(const httplib::Request& req, httplib::Response& resp);
+    void get_pool_metrics(const httplib::Request& req,
+                          httplib::Response& resp);
 
 private:
     const std::shared_ptr<Initialize> get_initialize();
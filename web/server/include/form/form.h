@@ -8,38 +8,48 @@
 
 #include "nlohmann/json.hpp"
 
+// pool is optional, jobs without it run on the default pool,
+// time_zone is optional, jobs without it use time_location
 struct InsertCronTaskForm
 {
     std::string cron;
     std::string callback_url;
+    std::string pool;
+    std::string time_zone;
 };
 
 inline void from_json(const nlohmann::json& j, InsertCronTaskForm& params)
 {
     j.at("cron").get_to(params.cron);
     j.at("callback_url").get_to(params.callback_url);
+    params.pool = j.value("pool", "");
+    params.time_zone = j.value("time_zone", "");
 }
 
 struct InsertOnceTaskForm
 {
     std::string run_at;
     std::string callback_url;
+    std::string pool;
 };
 
 inline void from_json(const nlohmann::json& j, InsertOnceTaskForm& params)
 {
     j.at("run_at").get_to(params.run_at);
     j.at("callback_url").get_to(params.callback_url);
+    params.pool = j.value("pool", "");
 }
 
 struct InsertImmediateTaskForm
 {
     std::string callback_url;
+    std::string pool;
 };
 
 inline void from_json(const nlohmann::json& j, InsertImmediateTaskForm& params)
 {
     j.at("callback_url").get_to(params.callback_url);
+    params.pool = j.value("pool", "");
 }
 
 struct SetCallbackForm
@@ -79,6 +89,7 @@ struct Metrics
     size_t execution_count;
     size_t success_count;
     size_t error_count;
+    size_t misfire_count;
 
     std::string last_run_time;
     int64_t last_duration;
@@ -102,6 +113,7 @@ inline void to_json(nlohmann::json& j, const Metrics& metrics)
     j = nlohmann::json{{"execution_count", metrics.execution_count},
                        {"success_count", metrics.success_count},
                        {"error_count", metrics.error_count},
+                       {"misfire_count", metrics.misfire_count},
                        {"last_run_time", metrics.last_run_time},
                        {"last_duration", metrics.last_duration},
                        {"total_duration", metrics.total_duration},
@@ -120,6 +132,7 @@ inline void from_json(const nlohmann::json& j, Metrics& metrics)
     j.at("execution_count").get_to(metrics.execution_count);
     j.at("success_count").get_to(metrics.success_count);
     j.at("error_count").get_to(metrics.error_count);
+    j.at("misfire_count").get_to(metrics.misfire_count);
     j.at("last_run_time").get_to(metrics.last_run_time);
     j.at("last_duration").get_to(metrics.last_duration);
     j.at("total_duration").get_to(metrics.total_duration);
@@ -133,6 +146,38 @@ inline void from_json(const nlohmann::json& j, Metrics& metrics)
     j.at("error_rate").get_to(metrics.error_rate);
 }
 
+struct PoolMetrics
+{
+    std::string name;
+    size_t threads;
+    size_t active_threads;
+    size_t queued;
+    size_t max_queue;
+    size_t completed;
+    size_t failed;
+    size_t rejected;
+    size_t dropped;
+    size_t caller_runs;
+    size_t blocked;
+    double utilization;
+};
+
+inline void to_json(nlohmann::json& j, const PoolMetrics& metrics)
+{
+    j = nlohmann::json{{"name", metrics.name},
+                       {"threads", metrics.threads},
+                       {"active_threads", metrics.active_threads},
+                       {"queued", metrics.queued},
+                       {"max_queue", metrics.max_queue},
+                       {"completed", metrics.completed},
+                       {"failed", metrics.failed},
+                       {"rejected", metrics.rejected},
+                       {"dropped", metrics.dropped},
+                       {"caller_runs", metrics.caller_runs},
+                       {"blocked", metrics.blocked},
+                       {"utilization", metrics.utilization}};
+}
+
 inline std::chrono::system_clock::time_point parse_iso_time(
     const std::string& iso_time)
 {
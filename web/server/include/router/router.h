@@ -21,7 +21,9 @@ static const std::string RESULT_JOB = "/api/chronix/result";
 static const std::string METRICS_JOB = "/api/chronix/metrics";
 static const std::string COUNT_JOB = "/api/chronix/count";
 static const std::string COUNT_RUNNING_JOB = "/api/chronix/count/running";
+static const std::string COUNT_PAUSED_JOB = "/api/chronix/count/paused";
 static const std::string RUNNING = "/api/chronix/running";
+static const std::string POOL_METRICS = "/api/chronix/pool/metrics";
 
 std::unique_ptr<httplib::Server> Register(
     std::shared_ptr<Initialize>& initialize);
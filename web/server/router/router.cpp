@@ -98,10 +98,20 @@ std::unique_ptr<httplib::Server> Register(
             controller->get_running_job_count(req, resp);
         });
 
+        server->Get(COUNT_PAUSED_JOB, [controller](const httplib::Request& req,
+                                                   httplib::Response& resp) {
+            controller->get_paused_job_count(req, resp);
+        });
+
         server->Get(RUNNING, [controller](const httplib::Request& req,
                                           httplib::Response& resp) {
             controller->get_running(req, resp);
         });
+
+        server->Get(POOL_METRICS, [controller](const httplib::Request& req,
+                                               httplib::Response& resp) {
+            controller->get_pool_metrics(req, resp);
+        });
     }
 
     return server;